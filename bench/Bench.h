@@ -0,0 +1,105 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+
+// Small helpers shared by the benchmark programs in bench/
+namespace Bench {
+    class Timer {
+    private:
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    public:
+        void restart() { start = std::chrono::steady_clock::now(); }
+        double seconds() const {
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+    };
+
+    // StudentManagement reads and writes data/ under the working directory, so every
+    // benchmark runs in a scratch directory of its own and never touches the real data files
+    class ScratchDirectory {
+    private:
+        std::filesystem::path previous = std::filesystem::current_path();
+        std::string path;
+
+    public:
+        explicit ScratchDirectory(const std::string& name) {
+            std::string pattern = (std::filesystem::temp_directory_path() / ("sms-" + name + "-XXXXXX")).string();
+            if (!mkdtemp(pattern.data())) {
+                std::cerr << "Could not create a scratch directory" << std::endl;
+                std::exit(1);
+            }
+            path = pattern;
+            std::filesystem::current_path(path);
+            std::filesystem::create_directory("data");
+        }
+        ~ScratchDirectory() {
+            std::filesystem::current_path(previous);
+            std::error_code ignored;
+            std::filesystem::remove_all(path, ignored);
+        }
+        ScratchDirectory(const ScratchDirectory&) = delete;
+        ScratchDirectory& operator=(const ScratchDirectory&) = delete;
+    };
+
+    // The first argument overrides the default problem size
+    inline long sizeArgument(int argc, char* argv[], long fallback) {
+        return argc >= 2 ? std::atol(argv[1]) : fallback;
+    }
+
+    // Resident memory of this process, from /proc
+    inline std::size_t residentBytes() {
+        std::ifstream statm("/proc/self/statm");
+        std::size_t pages = 0;
+        std::size_t resident = 0;
+        statm >> pages >> resident;
+        return resident * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    }
+
+    // Writes data/students.csv, courses.csv and enrollments.csv like the program saves them:
+    // roll numbers from 100000, every student in enrollmentsEach courses and enough courses
+    // that none is over its 200 seats. Some addresses hold a comma and are quoted
+    // Returns the number of courses
+    inline std::size_t writeDataset(std::size_t students, std::size_t enrollmentsEach) {
+        static const char* cities[] = {"\"Patna, Bihar\"", "Bhubaneswar", "\"Pune, Maharashtra\"", "Kolkata"};
+        std::size_t courses = students * enrollmentsEach / 150 + 1;
+        char line[256];
+
+        std::ofstream studentFile("data/students.csv", std::ios::binary);
+        studentFile << "id,name,rollNo,grade,attendance,email,phone,address\n";
+        for (std::size_t i = 0; i < students; i++) {
+            int length = std::snprintf(line, sizeof(line), "%zu,Student %zu,%zu,%f,%f,student%zu@mail.com,9%09zu,%s\n",
+                                       i + 1, i, 100000 + i, (i * 37 % 1001) / 10.0, (i * 53 % 1001) / 10.0,
+                                       i, i, cities[i % 4]);
+            studentFile.write(line, length);
+        }
+
+        std::ofstream courseFile("data/courses.csv", std::ios::binary);
+        courseFile << "id,code,name,instructor,credits,maxCapacity\n";
+        for (std::size_t c = 0; c < courses; c++) {
+            int length = std::snprintf(line, sizeof(line), "%zu,C%zu,Course %zu,Instructor %zu,%zu,200\n",
+                                       c + 1, c, c, c % 50, c % 4 + 1);
+            courseFile.write(line, length);
+        }
+
+        std::ofstream enrollmentFile("data/enrollments.csv", std::ios::binary);
+        enrollmentFile << "studentId,courseId\n";
+        for (std::size_t i = 0; i < students; i++) {
+            for (std::size_t k = 0; k < enrollmentsEach; k++) {
+                int length = std::snprintf(line, sizeof(line), "%zu,%zu\n", i + 1, (i + k * 7919) % courses + 1);
+                enrollmentFile.write(line, length);
+            }
+        }
+        return courses;
+    }
+}
+
+#endif // BENCH_H
@@ -0,0 +1,45 @@
+#ifndef COUNTING_NEW_H
+#define COUNTING_NEW_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+// Replaces the global operator new of a benchmark program to count heap allocations
+// Include it in exactly one file of the program; every thread is counted
+namespace Bench {
+    inline std::atomic<std::size_t> heapAllocations{0};
+
+    inline std::size_t allocations() { return heapAllocations.load(std::memory_order_relaxed); }
+}
+
+void* operator new(std::size_t size) {
+    Bench::heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* pointer = std::malloc(size ? size : 1)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+#endif // COUNTING_NEW_H
@@ -0,0 +1,112 @@
+#include "Bench.h"
+#include "../include/StudentManagement.h"
+#include "../include/AnalyticsStore.h"
+#include "../include/Kernels.h"
+#include <iomanip>
+#include <vector>
+
+// The report scans (average grade, attendance >= 75 count, grade/attendance histogram)
+// as per-object loops over the Student records, the way the reports used to do them,
+// next to the same scans over the analytics columns with the selection and histogram
+// kernels. Fails if the two sides disagree
+static const int rounds = 20;
+
+struct ScanResult {
+    double gradeSum = 0;
+    std::size_t regular = 0;
+    Kernels::RosterHistogram histogram;
+};
+
+static ScanResult scanObjects(const SlotMap<Student>& students) {
+    ScanResult result;
+    for (const Student& s : students) {
+        result.gradeSum += s.getGrade();
+    }
+    for (const Student& s : students) {
+        if (s.getAttendance() >= 75) {
+            result.regular++;
+        }
+    }
+    for (const Student& s : students) {
+        float grade = s.getGrade();
+        if (grade >= 90) result.histogram.grade[0]++;
+        else if (grade >= 80) result.histogram.grade[1]++;
+        else if (grade >= 70) result.histogram.grade[2]++;
+        else if (grade >= 60) result.histogram.grade[3]++;
+        else if (grade >= 50) result.histogram.grade[4]++;
+        else result.histogram.grade[5]++;
+
+        float attendance = s.getAttendance();
+        if (attendance >= 90) result.histogram.attendance[0]++;
+        else if (attendance >= 80) result.histogram.attendance[1]++;
+        else if (attendance >= 75) result.histogram.attendance[2]++;
+        else result.histogram.attendance[3]++;
+    }
+    return result;
+}
+
+static ScanResult scanColumns(const AnalyticsStore& analytics, std::vector<std::uint64_t>& mask) {
+    ScanResult result;
+    for (float grade : analytics.grades()) {
+        result.gradeSum += grade;
+    }
+    Kernels::selectMask(analytics.attendance().data(), analytics.size(), Kernels::Compare::GreaterEqual, 75, mask);
+    for (std::uint64_t word : mask) {
+        result.regular += __builtin_popcountll(word);
+    }
+    result.histogram = Kernels::rosterHistogram(analytics.grades().data(), analytics.attendance().data(),
+                                                analytics.size());
+    return result;
+}
+
+static bool sameResult(const ScanResult& a, const ScanResult& b) {
+    if (a.gradeSum != b.gradeSum || a.regular != b.regular) {
+        return false;
+    }
+    for (int k = 0; k < 6; k++) {
+        if (a.histogram.grade[k] != b.histogram.grade[k]) return false;
+    }
+    for (int k = 0; k < 4; k++) {
+        if (a.histogram.attendance[k] != b.histogram.attendance[k]) return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    const std::size_t students = static_cast<std::size_t>(Bench::sizeArgument(argc, argv, 1000000));
+    Bench::ScratchDirectory scratch("analytics-scan");
+    Bench::writeDataset(students, 1);
+    StudentManagement sm;
+
+    AnalyticsStore analytics;
+    analytics.rebuild(sm.getStudents());
+    std::vector<std::uint64_t> mask;
+
+    ScanResult objects = scanObjects(sm.getStudents());
+    ScanResult columns = scanColumns(analytics, mask);
+    bool ok = sameResult(objects, columns);
+
+    Bench::Timer timer;
+    for (int r = 0; r < rounds; r++) {
+        objects = scanObjects(sm.getStudents());
+    }
+    double objectSeconds = timer.seconds() / rounds;
+    timer.restart();
+    for (int r = 0; r < rounds; r++) {
+        columns = scanColumns(analytics, mask);
+    }
+    double columnSeconds = timer.seconds() / rounds;
+    ok = ok && sameResult(objects, columns);
+
+    std::cout << std::fixed << std::setprecision(2) << sm.getStudents().size() << " students, kernels use "
+              << Kernels::activeInstructionSet() << std::endl;
+    std::cout << "Per-object scans: " << objectSeconds * 1e3 << " ms" << std::endl;
+    std::cout << "Column scans:     " << columnSeconds * 1e3 << " ms (" << std::setprecision(1)
+              << objectSeconds / columnSeconds << "x faster)" << std::endl;
+    std::cout << "Average grade " << std::setprecision(2) << columns.gradeSum / students << ", "
+              << columns.regular << " students at or above 75% attendance" << std::endl;
+    if (!ok) {
+        std::cout << "The column scans disagree with the per-object scans" << std::endl;
+    }
+    return ok ? 0 : 1;
+}
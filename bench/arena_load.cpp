@@ -0,0 +1,78 @@
+#include "CountingNew.h"
+#include "Bench.h"
+#include "../include/StudentManagement.h"
+#include <iomanip>
+#include <malloc.h>
+#include <memory>
+
+// Heap allocations and resident memory of loading 1M students with 3 enrollments each
+// into the arena-backed store, how long the teardown takes and what it gives back, then
+// two more loads to show nothing piles up.
+// The teardown is not O(1): it still runs a destructor per record and walks the nodes of
+// the sorted and hash indexes, but nothing is freed one by one. The arena, the index pools
+// and the enrollment sets go back in whole blocks.
+// glibc keeps freed blocks in the heaps of the loader threads instead of returning them to
+// the system, so RSS after a teardown is read after malloc_trim.
+// Fails if a load allocates once per student or more, a reload allocates more than the
+// first load, or RSS after a reload's teardown is more than 16 MB above the first one's
+struct LoadResult {
+    std::size_t allocations = 0;
+    std::size_t students = 0;
+    double loadSeconds = 0;
+    double teardownSeconds = 0;
+    std::size_t residentLoaded = 0;
+    std::size_t residentAfter = 0;
+};
+
+static LoadResult loadAndDrop() {
+    LoadResult result;
+    std::size_t before = Bench::allocations();
+    Bench::Timer timer;
+    auto sm = std::make_unique<StudentManagement>();
+    result.loadSeconds = timer.seconds();
+    result.allocations = Bench::allocations() - before;
+    result.students = sm->getStudents().size();
+    result.residentLoaded = Bench::residentBytes();
+
+    timer.restart();
+    sm.reset();
+    result.teardownSeconds = timer.seconds();
+    malloc_trim(0);
+    result.residentAfter = Bench::residentBytes();
+    return result;
+}
+
+static void print(const char* label, const LoadResult& result, std::size_t residentStart) {
+    const double mb = 1024.0 * 1024.0;
+    std::cout << std::fixed << std::setprecision(1) << label << ": " << result.students << " students in "
+              << result.loadSeconds * 1e3 << " ms, " << result.allocations << " allocations ("
+              << std::setprecision(3) << static_cast<double>(result.allocations) / result.students
+              << " per student)" << std::endl;
+    std::cout << std::setprecision(1) << "  RSS " << residentStart / mb << " MB before, "
+              << result.residentLoaded / mb << " MB loaded, " << result.residentAfter / mb
+              << " MB after a teardown of " << result.teardownSeconds * 1e3 << " ms" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    const std::size_t students = static_cast<std::size_t>(Bench::sizeArgument(argc, argv, 1000000));
+    Bench::ScratchDirectory scratch("arena-load");
+    Bench::writeDataset(students, 3);
+
+    std::size_t residentStart = Bench::residentBytes();
+    LoadResult first = loadAndDrop();
+    print("First load", first, residentStart);
+    LoadResult second = loadAndDrop();
+    print("Reload", second, first.residentAfter);
+    LoadResult third = loadAndDrop();
+    print("Third load", third, second.residentAfter);
+
+    const std::size_t residentSlack = 16 * 1024 * 1024;
+    bool ok = first.students == students && second.students == students && third.students == students &&
+              first.allocations < students && second.allocations <= first.allocations &&
+              third.allocations <= first.allocations && second.residentAfter <= first.residentAfter + residentSlack &&
+              third.residentAfter <= first.residentAfter + residentSlack;
+    if (!ok) {
+        std::cout << "The loads allocate per student or grow from one load to the next" << std::endl;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,123 @@
+#include "Bench.h"
+#include "../include/CsvReader.h"
+#include "../include/StudentManagement.h"
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+// Load time of the three data files, three ways:
+//  - the old loader: getline, a stringstream split into a vector of strings, stoi/stof
+//  - the mmap tokenizer with from_chars on one thread
+//  - a full StudentManagement startup: parallel parse, records, indexes and enrollment links
+// The first two parse into the same plain rows and must agree on the counts
+struct Totals {
+    std::size_t rows = 0;
+    long long checksum = 0; // Sum of the ids and roll numbers, so nothing is optimised away
+};
+
+// The data files and the number column each one adds to the checksum next to its id
+struct DataFile {
+    const char* path;
+    std::size_t column;
+};
+
+static const DataFile files[] = {
+    {"data/students.csv", 2},   // roll number; the grade is parsed too
+    {"data/courses.csv", 4},    // credits
+    {"data/enrollments.csv", 1} // course id
+};
+
+static Totals loadTheOldWay() {
+    Totals totals;
+    for (const auto& dataFile : files) {
+        std::ifstream inFile(dataFile.path);
+        std::string line;
+        std::getline(inFile, line);
+        while (std::getline(inFile, line)) {
+            std::stringstream ss(line);
+            std::string token;
+            std::vector<std::string> tokens;
+            while (std::getline(ss, token, ',')) {
+                tokens.push_back(token);
+            }
+            totals.rows++;
+            totals.checksum += std::stoi(tokens[0]) + std::stoi(tokens[dataFile.column]);
+            if (dataFile.column == 2) {
+                totals.checksum += static_cast<long long>(std::stof(tokens[3]));
+            }
+        }
+    }
+    return totals;
+}
+
+static Totals loadTheNewWay() {
+    Totals totals;
+    std::vector<std::string_view> fields;
+    for (const auto& dataFile : files) {
+        MappedFile file(dataFile.path);
+        CsvReader reader(file.begin(), file.end());
+        reader.nextRow(fields);
+        while (reader.nextRow(fields)) {
+            int id = 0;
+            int value = 0;
+            Csv::parseInt(fields[0], id);
+            Csv::parseInt(fields[dataFile.column], value);
+            totals.rows++;
+            totals.checksum += id + value;
+            if (dataFile.column == 2) {
+                float grade = 0;
+                Csv::parseFloat(fields[3], grade);
+                totals.checksum += static_cast<long long>(grade);
+            }
+        }
+    }
+    return totals;
+}
+
+int main(int argc, char* argv[]) {
+    const std::size_t students = static_cast<std::size_t>(Bench::sizeArgument(argc, argv, 500000));
+    const std::size_t enrollmentsEach = 3;
+    Bench::ScratchDirectory scratch("csv-load");
+    std::size_t courses = Bench::writeDataset(students, enrollmentsEach);
+    std::size_t rows = students + courses + students * enrollmentsEach;
+    std::cout << students << " students, " << courses << " courses, " << students * enrollmentsEach
+              << " enrollments" << std::endl;
+
+    // One untimed pass first, so every variant reads from the page cache
+    loadTheNewWay();
+
+    Bench::Timer timer;
+    Totals old = loadTheOldWay();
+    double oldSeconds = timer.seconds();
+    timer.restart();
+    Totals fresh = loadTheNewWay();
+    double newSeconds = timer.seconds();
+    timer.restart();
+    std::size_t loaded;
+    {
+        StudentManagement sm;
+        loaded = sm.getStudents().size();
+        timer.restart();
+    }
+    double teardownSeconds = timer.seconds();
+    timer.restart();
+    {
+        StudentManagement sm;
+        loaded = sm.getStudents().size();
+        std::cout << std::fixed << std::setprecision(3);
+        std::cout << "getline + stringstream + stoi:   " << oldSeconds << " s ("
+                  << static_cast<long long>(rows / oldSeconds) << " rows/sec)" << std::endl;
+        std::cout << "mmap + string_view + from_chars: " << newSeconds << " s ("
+                  << static_cast<long long>(rows / newSeconds) << " rows/sec), "
+                  << oldSeconds / newSeconds << "x" << std::endl;
+        std::cout << "full startup (parallel):         " << timer.seconds() << " s, " << loaded
+                  << " students loaded" << std::endl;
+    }
+    std::cout << "teardown of the loaded store:    " << teardownSeconds << " s" << std::endl;
+
+    if (old.rows != rows || fresh.rows != rows || old.checksum != fresh.checksum || loaded != students) {
+        std::cout << "The loaders disagree" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,84 @@
+#include "Bench.h"
+#include "../include/StudentManagement.h"
+#include "../include/CsvWriter.h"
+#include <iomanip>
+
+// Save throughput of the students file: the old toCSV rows built with operator+ and
+// std::to_string and written with std::endl, against CsvWriter with to_chars and block
+// writes, then a full save of every file through the background writer.
+// Fails if CsvWriter's file doesn't load back to the same students
+static std::string oldToCSV(const Student& s) {
+    // What Student::toCSV used to return; it never quoted the address
+    return std::to_string(s.getId()) + "," +
+           std::string(s.getName()) + "," +
+           std::to_string(s.getRollNo()) + "," +
+           std::to_string(s.getGrade()) + "," +
+           std::to_string(s.getAttendance()) + "," +
+           std::string(s.getEmail()) + "," +
+           std::string(s.getPhone()) + "," +
+           std::string(s.getAddress());
+}
+
+static double megabytes(const char* path) {
+    return std::filesystem::file_size(path) / 1e6;
+}
+
+int main(int argc, char* argv[]) {
+    const std::size_t students = static_cast<std::size_t>(Bench::sizeArgument(argc, argv, 1000000));
+    Bench::ScratchDirectory scratch("csv-save");
+    Bench::writeDataset(students, 3);
+    std::size_t loaded = 0;
+    double oldSeconds = 0;
+    double writerSeconds = 0;
+    double fullSeconds = 0;
+    bool saved = false;
+    {
+        StudentManagement sm;
+        sm.setFlushPolicy({FlushPolicy::OnExit, 0});
+        loaded = sm.getStudents().size();
+
+        Bench::Timer timer;
+        {
+            std::ofstream out("old.csv");
+            out << "id,name,rollNo,grade,attendance,email,phone,address" << std::endl;
+            for (const auto& student : sm.getStudents()) {
+                out << oldToCSV(student) << std::endl;
+            }
+        }
+        oldSeconds = timer.seconds();
+
+        timer.restart();
+        {
+            std::ofstream out("new.csv", std::ios::binary);
+            CsvWriter writer(out);
+            writer.line("id,name,rollNo,grade,attendance,email,phone,address");
+            for (const auto& student : sm.getStudents()) {
+                student.writeCSV(writer);
+            }
+        }
+        writerSeconds = timer.seconds();
+
+        timer.restart();
+        sm.compactDataFiles();
+        saved = sm.flushAndWait();
+        fullSeconds = timer.seconds();
+    }
+
+    // The students file the writer produced has to load back to the same store
+    std::filesystem::copy_file("new.csv", "data/students.csv", std::filesystem::copy_options::overwrite_existing);
+    std::filesystem::remove("data/store.snap");
+    std::size_t reloaded = StudentManagement().getStudents().size();
+
+    std::cout << std::fixed << std::setprecision(1) << loaded << " students" << std::endl;
+    std::cout << "toCSV + std::endl:  " << oldSeconds * 1e3 << " ms, " << megabytes("old.csv") / oldSeconds
+              << " MB/s" << std::endl;
+    std::cout << "CsvWriter:          " << writerSeconds * 1e3 << " ms, " << megabytes("new.csv") / writerSeconds
+              << " MB/s (" << oldSeconds / writerSeconds << "x faster)" << std::endl;
+    std::cout << "Full save (3 CSV files and the snapshot, fsynced): " << fullSeconds * 1e3 << " ms" << std::endl;
+
+    bool ok = saved && reloaded == loaded;
+    if (!ok) {
+        std::cout << (saved ? "The saved students file doesn't load back" : "The full save failed") << std::endl;
+    }
+    return ok ? 0 : 1;
+}
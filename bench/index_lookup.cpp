@@ -0,0 +1,65 @@
+#include "Bench.h"
+#include "../include/StudentManagement.h"
+#include <algorithm>
+#include <iomanip>
+#include <random>
+#include <vector>
+
+// Roll number and course code lookups through the hash indexes at growing store sizes,
+// next to the linear scan they replaced. The indexed cost per lookup should stay flat
+// while the scan grows with the store. Fails if any lookup misses
+static const std::size_t lookups = 1000000;
+static const std::size_t scans = 200;
+
+static bool measure(std::size_t students) {
+    Bench::ScratchDirectory scratch("index-lookup");
+    std::size_t courses = Bench::writeDataset(students, 1);
+    StudentManagement sm;
+
+    std::mt19937 random(42);
+    std::vector<int> rollNos(lookups);
+    std::vector<std::string> codes(lookups);
+    for (std::size_t i = 0; i < lookups; i++) {
+        rollNos[i] = static_cast<int>(100000 + random() % students);
+        codes[i] = "C" + std::to_string(random() % courses);
+    }
+
+    std::size_t found = 0;
+    Bench::Timer timer;
+    for (int rollNo : rollNos) {
+        found += sm.searchStudentByRoll(rollNo) != nullptr;
+    }
+    double rollSeconds = timer.seconds();
+    timer.restart();
+    for (const auto& code : codes) {
+        found += sm.searchCourseByCode(code) != nullptr;
+    }
+    double codeSeconds = timer.seconds();
+
+    // What searchStudentByRoll did before the index
+    timer.restart();
+    for (std::size_t i = 0; i < scans; i++) {
+        const auto& all = sm.getStudents();
+        found += std::find_if(all.begin(), all.end(), [&](const Student& s) {
+            return s.getRollNo() == rollNos[i];
+        }) != all.end();
+    }
+    double scanSeconds = timer.seconds();
+
+    std::cout << std::fixed << std::setprecision(1) << students << " students, " << courses << " courses: roll lookup "
+              << rollSeconds / lookups * 1e9 << " ns, code lookup " << codeSeconds / lookups * 1e9
+              << " ns, linear scan " << scanSeconds / scans * 1e6 << " us" << std::endl;
+    return found == 2 * lookups + scans;
+}
+
+int main(int argc, char* argv[]) {
+    const std::size_t largest = static_cast<std::size_t>(Bench::sizeArgument(argc, argv, 1000000));
+    bool ok = true;
+    for (std::size_t students = 1000; students <= largest; students *= 10) {
+        ok = measure(students) && ok;
+    }
+    if (!ok) {
+        std::cout << "Some lookups missed" << std::endl;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,193 @@
+#include "Bench.h"
+#include "../include/ConcurrentStudentManagement.h"
+#include "../include/HttpServer.h"
+#include "../include/StudentApi.h"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <atomic>
+#include <cstring>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+// Load generator for the server mode
+//   bench/build/loadgen [requests]          starts its own server on a scratch data set
+//   bench/build/loadgen [requests] [port]   drives a running --serve on 127.0.0.1:port
+// Keep-alive clients each send one request at a time, a portal-like mix of lookups,
+// enrollments, drops and reports, and the latencies of all of them give p50/p99
+static const int clientCount = 32;
+static const int studentCount = 10000;
+static const int courseCount = 20;
+
+struct ClientResult {
+    std::vector<double> latenciesUs;
+    std::size_t failures = 0;
+};
+
+static std::string requestFor(std::size_t i, int firstRoll) {
+    int rollNo = firstRoll + static_cast<int>(i * 7919 % studentCount);
+    std::string code = "LG" + std::to_string(i % courseCount);
+    switch (i % 20) {
+        case 14:
+        case 15:
+            return "GET /courses/" + code + " HTTP/1.1\r\nHost: localhost\r\n\r\n";
+        case 16:
+            return "POST /enrollments?roll=" + std::to_string(rollNo) + "&code=" + code +
+                   " HTTP/1.1\r\nHost: localhost\r\nContent-Length: 0\r\n\r\n";
+        case 17:
+            return "DELETE /enrollments?roll=" + std::to_string(rollNo) + "&code=" + code +
+                   " HTTP/1.1\r\nHost: localhost\r\n\r\n";
+        case 18:
+            return "GET /reports/top?count=10 HTTP/1.1\r\nHost: localhost\r\n\r\n";
+        case 19:
+            return "GET /reports/histogram HTTP/1.1\r\nHost: localhost\r\n\r\n";
+        default:
+            return "GET /students/" + std::to_string(rollNo) + " HTTP/1.1\r\nHost: localhost\r\n\r\n";
+    }
+}
+
+static int connectTo(int port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<std::uint16_t>(port));
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (fd < 0 || connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        return -1;
+    }
+    int noDelay = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+    return fd;
+}
+
+// Sends one request and reads its whole response; returns the status, or 0 when the connection broke
+static int exchange(int fd, const std::string& request, std::string& buffer) {
+    if (::send(fd, request.data(), request.size(), MSG_NOSIGNAL) != static_cast<ssize_t>(request.size())) {
+        return 0;
+    }
+    buffer.clear();
+    std::size_t headerEnd;
+    while ((headerEnd = buffer.find("\r\n\r\n")) == std::string::npos) {
+        char chunk[16 * 1024];
+        ssize_t count = ::recv(fd, chunk, sizeof(chunk), 0);
+        if (count <= 0) {
+            return 0;
+        }
+        buffer.append(chunk, static_cast<std::size_t>(count));
+    }
+    std::size_t length = 0;
+    std::size_t header = buffer.find("Content-Length: ");
+    if (header != std::string::npos && header < headerEnd) {
+        length = std::stoul(buffer.substr(header + 16));
+    }
+    while (buffer.size() < headerEnd + 4 + length) {
+        char chunk[16 * 1024];
+        ssize_t count = ::recv(fd, chunk, sizeof(chunk), 0);
+        if (count <= 0) {
+            return 0;
+        }
+        buffer.append(chunk, static_cast<std::size_t>(count));
+    }
+    return buffer.size() > 12 ? std::atoi(buffer.c_str() + 9) : 0;
+}
+
+static void runClient(int port, std::size_t first, std::size_t count, int firstRoll, ClientResult& result) {
+    result.latenciesUs.reserve(count);
+    int fd = connectTo(port);
+    std::string buffer;
+    for (std::size_t i = first; i < first + count; i++) {
+        if (fd < 0) {
+            result.failures += first + count - i;
+            return;
+        }
+        std::string request = requestFor(i, firstRoll);
+        Bench::Timer timer;
+        int status = exchange(fd, request, buffer);
+        result.latenciesUs.push_back(timer.seconds() * 1e6);
+        // 404 and 409 are real answers (unknown or already enrolled); only errors count
+        if (status == 0 || status >= 500) {
+            result.failures++;
+            ::close(fd);
+            fd = connectTo(port);
+        }
+    }
+    if (fd >= 0) {
+        ::close(fd);
+    }
+}
+
+static bool drive(int port, std::size_t requests, int firstRoll) {
+    std::vector<ClientResult> results(clientCount);
+    std::vector<std::thread> clients;
+    Bench::Timer timer;
+    for (int c = 0; c < clientCount; c++) {
+        std::size_t first = requests * c / clientCount;
+        std::size_t last = requests * (c + 1) / clientCount;
+        clients.emplace_back(runClient, port, first, last - first, firstRoll, std::ref(results[c]));
+    }
+    for (auto& client : clients) {
+        client.join();
+    }
+    double seconds = timer.seconds();
+
+    std::vector<double> latencies;
+    std::size_t failures = 0;
+    for (const auto& result : results) {
+        latencies.insert(latencies.end(), result.latenciesUs.begin(), result.latenciesUs.end());
+        failures += result.failures;
+    }
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&latencies](double p) {
+        return latencies.empty() ? 0.0 : latencies[static_cast<std::size_t>(p * (latencies.size() - 1))];
+    };
+    std::cout << requests << " requests over " << clientCount << " keep-alive connections in " << seconds
+              << " s: " << static_cast<long long>(requests / seconds) << " requests/sec" << std::endl;
+    std::cout << "latency p50 " << percentile(0.50) << " us, p99 " << percentile(0.99) << " us, max "
+              << percentile(1.0) << " us; " << failures << " failed" << std::endl;
+    return failures == 0;
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t requests = static_cast<std::size_t>(Bench::sizeArgument(argc, argv, 200000));
+    if (argc >= 3) {
+        // Against a running server its own data is used; roll numbers that don't exist just get 404
+        return drive(std::atoi(argv[2]), requests, 1) ? 0 : 1;
+    }
+
+    Bench::ScratchDirectory scratch("loadgen");
+    bool ok;
+    {
+        StudentManagement sm;
+        sm.setFlushPolicy({FlushPolicy::OnExit, 0});
+        std::string error;
+        sm.beginBulkUpdate();
+        for (int i = 0; i < studentCount; i++) {
+            sm.insertStudent("Student " + std::to_string(i), 1000 + i, static_cast<float>(i % 101),
+                             static_cast<float>(i * 37 % 101), "", "", "", error);
+        }
+        for (int c = 0; c < courseCount; c++) {
+            sm.insertCourse("LG" + std::to_string(c), "Load Course " + std::to_string(c), "Dr. Rao", 4, 200, error);
+        }
+        sm.endBulkUpdate();
+
+        ConcurrentStudentManagement store(sm);
+        HttpServer server([&store](const HttpRequest& request) { return StudentApi::handle(store, request); });
+        if (!server.start(0, error)) {
+            std::cerr << "Could not start the server: " << error << std::endl;
+            return 1;
+        }
+        std::thread loop([&server]() { server.run(); });
+        ok = drive(server.getPort(), requests, 1000);
+        server.stop();
+        loop.join();
+        store.flushDataFiles();
+        sm.waitForPendingWrites();
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,54 @@
+#include "CountingNew.h"
+#include "Bench.h"
+#include "../include/StudentManagement.h"
+#include <iomanip>
+
+// Heap allocations of a full save (all three CSV files and the snapshot) at two store
+// sizes. The save path formats rows into reusable buffers and walks the enrollment sets
+// in place, so the count must not grow with the number of rows. Fails if it does
+struct SaveCount {
+    std::size_t rows = 0;
+    std::size_t allocations = 0;
+};
+
+static SaveCount countSave(std::size_t students) {
+    Bench::ScratchDirectory scratch("save-allocations");
+    Bench::writeDataset(students, 3);
+    StudentManagement sm;
+    sm.setFlushPolicy({FlushPolicy::OnExit, 0});
+
+    // The first save sizes the buffers; the second one is what's counted
+    sm.compactDataFiles();
+    sm.flushAndWait();
+
+    std::size_t before = Bench::allocations();
+    sm.compactDataFiles();
+    bool saved = sm.flushAndWait();
+    SaveCount count;
+    count.allocations = Bench::allocations() - before;
+    count.rows = sm.getStudents().size() * 4 + sm.getCourses().size();
+    if (!saved) {
+        std::cout << "The save failed" << std::endl;
+        std::exit(1);
+    }
+
+    std::cout << sm.getStudents().size() << " students, " << count.rows << " rows: "
+              << count.allocations << " allocations" << std::endl;
+    return count;
+}
+
+int main(int argc, char* argv[]) {
+    const std::size_t students = static_cast<std::size_t>(Bench::sizeArgument(argc, argv, 200000));
+    SaveCount small = countSave(students / 4);
+    SaveCount large = countSave(students);
+
+    double perRow = (static_cast<double>(large.allocations) - static_cast<double>(small.allocations)) /
+                    static_cast<double>(large.rows - small.rows);
+    std::cout << std::fixed << std::setprecision(4) << "Allocations per extra row: " << perRow << std::endl;
+    // A few buffers more for the larger store are fine; one per row or per hundred rows is not
+    bool ok = perRow < 0.001;
+    if (!ok) {
+        std::cout << "The save path allocates per row" << std::endl;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,122 @@
+#include "Bench.h"
+#include "../include/ConcurrentStudentManagement.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// Registration opening against one hot course: 64 threads send every student of the intake
+// at the same course of 200 seats, first with plain enrollments mixed with drops and then
+// through reserve -> confirm/cancel with the waitlist. Fails when the course is oversold
+static const int threadCount = 64;
+static const int capacity = 200;
+
+// expected < 0 only checks that the course is not oversold and its roster agrees with the count
+static bool checkSeats(ConcurrentStudentManagement& store, const std::string& code, int expected) {
+    int seated = store.findCourse(code)->getCurrentEnrollment();
+    int roster = static_cast<int>(store.getRoster(code).size());
+    std::cout << "  " << code << ": " << seated << "/" << capacity << " seats, roster of " << roster;
+    if (seated > capacity || roster != seated || (expected >= 0 && seated != expected)) {
+        std::cout << " - OVERSOLD OR LOST";
+        if (expected >= 0) {
+            std::cout << ", expected " << expected;
+        }
+        std::cout << std::endl;
+        return false;
+    }
+    std::cout << ", ok" << std::endl;
+    return true;
+}
+
+template <typename Work>
+static double runThreads(Work work) {
+    Bench::Timer timer;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; t++) {
+        threads.emplace_back(work, t);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return timer.seconds();
+}
+
+int main(int argc, char* argv[]) {
+    const int students = static_cast<int>(Bench::sizeArgument(argc, argv, 20000));
+    Bench::ScratchDirectory scratch("seat-stress");
+    bool ok = true;
+    {
+        StudentManagement sm;
+        sm.setFlushPolicy({FlushPolicy::OnExit, 0});
+        std::string error;
+        sm.beginBulkUpdate();
+        for (int i = 0; i < students; i++) {
+            sm.insertStudent("Student " + std::to_string(i), 1000 + i, 70, 90, "", "", "", error);
+        }
+        sm.insertCourse("HOT101", "Registration Rush", "Dr. Rao", 4, capacity, error);
+        sm.insertCourse("HOT102", "Waitlisted Rush", "Dr. Rao", 4, capacity, error);
+        sm.endBulkUpdate();
+
+        ConcurrentStudentManagement store(sm);
+        std::cout << students << " students, " << threadCount << " threads, one course of " << capacity
+                  << " seats" << std::endl;
+
+        // Plain enrollments; every 8th student who gets a seat drops it again right away
+        std::atomic<int> enrolled{0};
+        std::atomic<int> dropped{0};
+        double seconds = runThreads([&](int t) {
+            std::string error;
+            for (int i = t; i < students; i += threadCount) {
+                if (!store.enroll(1000 + i, "HOT101", error)) {
+                    continue;
+                }
+                enrolled++;
+                if (i % 8 == 0 && store.drop(1000 + i, "HOT101", error)) {
+                    dropped++;
+                }
+            }
+        });
+        std::cout << "enroll/drop: " << static_cast<long long>(students / seconds) << " requests/sec, "
+                  << static_cast<long long>(enrolled / seconds) << " enrollments/sec, " << enrolled
+                  << " enrolled, " << dropped << " dropped" << std::endl;
+        ok = checkSeats(store, "HOT101", enrolled - dropped) && ok;
+
+        // Reserve, then confirm or (every 5th) cancel; a full course puts the student on the
+        // waitlist, and every drop afterwards hands its seat to the head of the waitlist
+        std::atomic<int> confirmed{0};
+        std::atomic<int> waitlisted{0};
+        seconds = runThreads([&](int t) {
+            std::string error;
+            for (int i = t; i < students; i += threadCount) {
+                Reservation reservation = store.reserveSeat(1000 + i, "HOT102", true);
+                if (reservation.status == ReservationStatus::Waitlisted) {
+                    waitlisted++;
+                } else if (reservation.status == ReservationStatus::Held) {
+                    if (i % 5 == 0) {
+                        store.cancelReservation(reservation);
+                    } else if (store.confirmReservation(reservation, error)) {
+                        confirmed++;
+                    }
+                }
+            }
+        });
+        std::cout << "reserve/confirm: " << static_cast<long long>(students / seconds) << " requests/sec, "
+                  << confirmed << " confirmed, " << waitlisted << " waitlisted" << std::endl;
+
+        ok = checkSeats(store, "HOT102", -1) && ok;
+
+        // Everyone seated drops; each freed seat goes to the head of the waitlist
+        std::vector<Student> seated = store.getRoster("HOT102");
+        seconds = runThreads([&](int t) {
+            std::string error;
+            for (std::size_t i = t; i < seated.size(); i += threadCount) {
+                store.drop(seated[i].getRollNo(), "HOT102", error);
+            }
+        });
+        std::cout << "drop + waitlist promotion: " << static_cast<long long>(seated.size() / seconds)
+                  << " drops/sec" << std::endl;
+        ok = checkSeats(store, "HOT102", -1) && ok;
+        store.flushDataFiles();
+        sm.waitForPendingWrites();
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,74 @@
+#include "Bench.h"
+#include "../include/Utils.h"
+#include <iomanip>
+#include <regex>
+#include <vector>
+
+// Email and phone validations per second: the std::regex patterns the validators used to
+// build on every call, the same patterns compiled once, and the hand-written matchers.
+// Fails if the matchers and the regexes disagree on any input
+static bool regexEmail(const std::string& email) {
+    const std::regex pattern("(\\w+)(\\.|_)?(\\w*)@(\\w+)(\\.(\\w+))+");
+    return std::regex_match(email, pattern);
+}
+
+static bool regexPhone(const std::string& phone) {
+    const std::regex pattern("[\\d\\s\\-\\(\\)]+");
+    return std::regex_match(phone, pattern) && phone.length() >= 6;
+}
+
+static const std::regex compiledEmail("(\\w+)(\\.|_)?(\\w*)@(\\w+)(\\.(\\w+))+");
+static const std::regex compiledPhone("[\\d\\s\\-\\(\\)]+");
+
+template <typename Validate>
+static double rate(const std::vector<std::string>& emails, const std::vector<std::string>& phones, std::size_t count,
+                   std::size_t& accepted, Validate validate) {
+    accepted = 0;
+    Bench::Timer timer;
+    for (std::size_t i = 0; i < count; i++) {
+        accepted += validate(emails[i % emails.size()], phones[i % phones.size()]);
+    }
+    return 2 * count / timer.seconds();
+}
+
+int main(int argc, char* argv[]) {
+    const std::size_t count = static_cast<std::size_t>(Bench::sizeArgument(argc, argv, 1000000));
+
+    // Mostly well-formed values like an import file holds, with some broken ones
+    std::vector<std::string> emails, phones;
+    for (int i = 0; i < 1000; i++) {
+        std::string n = std::to_string(i);
+        emails.push_back(i % 10 == 0 ? "student" + n + "@mail" : i % 3 ? "student" + n + "@mail.com"
+                                                                       : "first.last_" + n + "@college.ac.in");
+        phones.push_back(i % 10 == 0 ? "98765-x" + n : i % 2 ? "9" + std::string(9 - n.size(), '0') + n
+                                                             : "(080) 2345-" + n);
+    }
+
+    // The old validators compiled their pattern on every call, so they only get a slice
+    std::size_t oldCount = count / 100;
+    std::size_t oldAccepted, compiledAccepted, matcherAccepted, sliceAccepted;
+    double oldRate = rate(emails, phones, oldCount, oldAccepted, [](const std::string& e, const std::string& p) {
+        return int(regexEmail(e)) + int(regexPhone(p));
+    });
+    double compiledRate = rate(emails, phones, count, compiledAccepted, [](const std::string& e, const std::string& p) {
+        return int(std::regex_match(e, compiledEmail)) + int(std::regex_match(p, compiledPhone) && p.length() >= 6);
+    });
+    double matcherRate = rate(emails, phones, count, matcherAccepted, [](const std::string& e, const std::string& p) {
+        return int(Validation::isValidEmail(e)) + int(Validation::isValidPhone(p));
+    });
+    rate(emails, phones, oldCount, sliceAccepted, [](const std::string& e, const std::string& p) {
+        return int(Validation::isValidEmail(e)) + int(Validation::isValidPhone(p));
+    });
+
+    std::cout << std::fixed << std::setprecision(0) << "regex built per call: " << oldRate << " validations/sec"
+              << std::endl;
+    std::cout << "regex compiled once: " << compiledRate << " validations/sec" << std::endl;
+    std::cout << "hand-written:        " << matcherRate << " validations/sec (" << std::setprecision(1)
+              << matcherRate / oldRate << "x the old validators)" << std::endl;
+
+    bool ok = sliceAccepted == oldAccepted && matcherAccepted == compiledAccepted;
+    if (!ok) {
+        std::cout << "The matchers and the regexes disagree" << std::endl;
+    }
+    return ok ? 0 : 1;
+}
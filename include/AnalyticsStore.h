@@ -0,0 +1,32 @@
+#ifndef ANALYTICS_STORE_H
+#define ANALYTICS_STORE_H
+
+#include <cstddef>
+#include <vector>
+#include "SlotMap.h"
+
+// A column-oriented mirror of the numbers the reports need
+// Row i always describes the student at packed position i of the student SlotMap,
+// so a report can scan tightly packed floats and only touch Student objects it prints
+class AnalyticsStore {
+private:
+    std::vector<float> gradeColumn;
+    std::vector<float> attendanceColumn;
+    std::vector<int> rollNoColumn;
+
+public:
+    // Full rebuild after loads
+    void rebuild(const SlotMap<Student>& students);
+
+    // Incremental maintenance that mirrors the SlotMap operations
+    void append(const Student& student);
+    void update(std::size_t row, const Student& student);
+    void swapRemove(std::size_t row);
+
+    std::size_t size() const { return gradeColumn.size(); }
+    const std::vector<float>& grades() const { return gradeColumn; }
+    const std::vector<float>& attendance() const { return attendanceColumn; }
+    const std::vector<int>& rollNumbers() const { return rollNoColumn; }
+};
+
+#endif // ANALYTICS_STORE_H
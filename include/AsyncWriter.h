@@ -0,0 +1,80 @@
+#ifndef ASYNC_WRITER_H
+#define ASYNC_WRITER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Counters for the background writer, read from the UI thread
+struct WriterMetrics {
+    std::size_t queueDepth = 0;    // Tasks submitted but not finished yet
+    std::size_t maxQueueDepth = 0;
+    std::size_t completed = 0;
+    std::size_t failed = 0;
+    double lastLatencyMs = 0;      // From submit to finished, for the last task
+    double averageLatencyMs = 0;
+    double maxLatencyMs = 0;
+};
+
+// My dedicated disk writer thread, so the menu never waits for file I/O
+// The UI thread is the only producer and the writer thread the only consumer, so the
+// tasks travel through a fixed size single-producer/single-consumer ring without locks.
+// The mutexes are only used to park the writer when the ring is empty and to let
+// waitForPending() sleep; a full ring makes submit() wait for a free slot.
+// Tasks run in submit order, which keeps journal appends and file rewrites ordered
+class AsyncWriter {
+private:
+    struct Task {
+        std::function<bool()> run; // Returns false when the write failed
+        std::chrono::steady_clock::time_point queuedAt;
+    };
+
+    std::vector<Task> ring;
+    std::atomic<std::size_t> head{0}; // Next slot to run, only advanced by the writer
+    std::atomic<std::size_t> tail{0}; // Next free slot, only advanced by the producer
+
+    std::thread worker;
+    std::atomic<bool> stopping{false};
+    std::atomic<bool> sleeping{false};
+    std::mutex parkMutex;
+    std::condition_variable parkCondition;
+    std::mutex doneMutex;
+    std::condition_variable doneCondition;
+
+    // Metrics, written by the writer thread
+    std::atomic<std::size_t> maxDepth{0};
+    std::atomic<std::size_t> failures{0};
+    std::atomic<std::size_t> unreportedFailures{0};
+    std::atomic<std::int64_t> lastLatencyUs{0};
+    std::atomic<std::int64_t> totalLatencyUs{0};
+    std::atomic<std::int64_t> maxLatencyUs{0};
+
+    bool isEmpty() const { return head.load() == tail.load(); }
+    void writerLoop();
+
+public:
+    explicit AsyncWriter(std::size_t capacity = 1024);
+    // Runs every task that is still queued before the thread stops, so shutdown is durable
+    ~AsyncWriter();
+    AsyncWriter(const AsyncWriter&) = delete;
+    AsyncWriter& operator=(const AsyncWriter&) = delete;
+
+    // Queues a task for the writer thread; only ever call this from one thread at a time
+    void submit(std::function<bool()> task);
+
+    // Blocks until every task submitted so far has finished
+    void waitForPending();
+
+    // Returns true once for every failed task since the last call
+    bool takeFailure();
+
+    WriterMetrics metrics() const;
+};
+
+#endif // ASYNC_WRITER_H
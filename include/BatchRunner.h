@@ -0,0 +1,49 @@
+#ifndef BATCH_RUNNER_H
+#define BATCH_RUNNER_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+class StudentManagement;
+
+// Why a command was rejected; field is empty when the row as a whole was refused
+struct BatchError {
+    std::size_t line;
+    std::string field;
+    std::string reason;
+};
+
+// What a batch run did, for the summary printed at the end
+struct BatchReport {
+    std::size_t commands = 0;
+    std::size_t applied = 0;
+    // In line order; a row that breaks several validation rules has one entry for each
+    std::vector<BatchError> errors;
+    // False when the data files could not be written at the end; batches are not
+    // journaled, so then nothing that was applied is on disk
+    bool persisted = true;
+    double validateSeconds = 0;
+    double applySeconds = 0;
+    double persistSeconds = 0;
+};
+
+// My non-interactive mode for bulk intakes and enrollment runs
+// Commands are CSV rows, one per line, for example
+//   add-student,Asha Verma,1042,88.5,92,asha@mail.com,9876543210,"Patna, Bihar"
+//   add-course,CS101,Intro to Programming,Dr. Rao,4,120
+//   enroll,1042,CS101
+//   drop,1042,CS101
+//   update-grade,1042,91
+//   delete-student,1042
+// Blank lines and lines starting with # are skipped. The added students and courses are
+// validated together on a worker pool first; rows that fail are not applied. Everything
+// else is applied in memory through StudentManagement and the data files are written once at the end
+namespace BatchRunner {
+    // Reads commands from a file, or from stdin when path is "-"
+    bool runFile(StudentManagement& sm, const std::string& path, BatchReport& report);
+    void run(StudentManagement& sm, char* begin, char* end, BatchReport& report);
+    void printReport(const BatchReport& report);
+}
+
+#endif // BATCH_RUNNER_H
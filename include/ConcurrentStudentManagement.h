@@ -0,0 +1,90 @@
+#ifndef CONCURRENT_STUDENT_MANAGEMENT_H
+#define CONCURRENT_STUDENT_MANAGEMENT_H
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+#include "StudentManagement.h"
+#include "SeatReservations.h"
+
+// Thread-safe front for a StudentManagement, so several worker threads can run lookups,
+// reports and enrollments at the same time
+// I lock in three levels, always in this order:
+//  - the store lock, shared by everything except changes to the tables themselves
+//    (adding, deleting, grades, flushes), which take it exclusively
+//  - one lock per student shard (by roll number), for that student's enrollment set
+//  - one lock per course shard (by course code), for that course's seat list
+// Seats are counted separately in SeatReservations: an enrollment first takes a seat with an
+// atomic compare-and-swap and only then locks its student and course shards to link the two,
+// so a course is never oversold and requests for a full course are turned away without a lock
+class ConcurrentStudentManagement {
+private:
+    static constexpr std::size_t shardCount = 64;
+
+    StudentManagement& store;
+    mutable std::shared_mutex storeMutex;
+    mutable std::array<std::shared_mutex, shardCount> studentShards;
+    mutable std::array<std::shared_mutex, shardCount> courseShards;
+    SeatReservations seats;
+
+    std::shared_mutex& studentShard(int rollNo) const;
+    std::shared_mutex& courseShard(const std::string& code) const;
+
+    // Copies taken under the record's shard lock, so a concurrent enrollment is never half seen
+    Student copyStudent(const Student& student) const;
+    std::vector<Student> copyStudents(const std::vector<const Student*>& found) const;
+
+    // Writes the data files when the flush policy says so, with the store locked exclusively
+    void flushIfDue();
+
+    // Links a student to a seat that is already taken; gives the seat back when that fails
+    bool confirmSeat(int rollNo, const std::string& code, std::string& error);
+    void releaseSeat(const std::string& code);
+    // Hands free seats to waitlisted students, in order
+    void promoteWaitlisted(const std::string& code);
+
+public:
+    // The store must outlive this object and is only used through it in the meantime
+    explicit ConcurrentStudentManagement(StudentManagement& store);
+    ~ConcurrentStudentManagement();
+    ConcurrentStudentManagement(const ConcurrentStudentManagement&) = delete;
+    ConcurrentStudentManagement& operator=(const ConcurrentStudentManagement&) = delete;
+
+    // Lookups return copies, since a pointer into the store would outlive the lock
+    std::optional<Student> findStudent(int rollNo) const;
+    std::optional<Course> findCourse(const std::string& code) const;
+    std::vector<std::string> getEnrolledCourseCodes(int rollNo) const;
+    std::vector<Student> getRoster(const std::string& code) const;
+
+    // Reports and filters run in parallel with each other and with enrollments
+    std::vector<Student> findTopPerformers(int count) const;
+    std::vector<Student> findStudentsByGradeRange(float minGrade, float maxGrade) const;
+    std::vector<Student> findStudentsByAttendance(float minAttendance) const;
+    Kernels::RosterHistogram getRosterHistogram() const;
+
+    // Enrollments only lock their own student and course shards
+    bool enroll(int rollNo, const std::string& code, std::string& error);
+    bool drop(int rollNo, const std::string& code, std::string& error);
+
+    // Two step enrollment: a seat is held first and confirmed or cancelled later
+    // With joinWaitlist a full course puts the student on its waitlist instead
+    Reservation reserveSeat(int rollNo, const std::string& code, bool joinWaitlist = false);
+    bool confirmReservation(Reservation& reservation, std::string& error);
+    void cancelReservation(Reservation& reservation);
+
+    // These change the tables and indexes, so they wait for every other call to finish
+    bool insertStudent(const std::string& name, int rollNo, float grade, float attendance,
+                       const std::string& email, const std::string& phone, const std::string& address,
+                       std::string& error);
+    bool insertCourse(const std::string& code, const std::string& name, const std::string& instructor,
+                      int credits, int maxCapacity, std::string& error);
+    bool setGrade(int rollNo, float grade, std::string& error);
+    std::size_t deleteStudents(const std::vector<int>& rollNos);
+    std::size_t deleteCourses(const std::vector<std::string>& codes);
+    void flushDataFiles();
+};
+
+#endif // CONCURRENT_STUDENT_MANAGEMENT_H
@@ -5,35 +5,50 @@
 #include <vector>
 #include <iostream>
 #include <iomanip>
+#include <memory_resource>
+#include <string_view>
+#include "SlotMap.h"
+#include "HandleSet.h"
+#include "RecordArena.h"
+#include "StringPool.h"
 
 // I needed to add this course management system to make my project more comprehensive
 // Using forward declaration to handle the circular dependency with Student class
 class Student;
+class CsvWriter;
+class ReportWriter;
 
 class Course {
 private:
     int id;
-    std::string code;
-    std::string name;
-    std::string instructor;
+    // The strings use the resource the record was built with, the arena for bulk loads
+    std::pmr::string code;
+    StringId name;       // Interned, sections of one course share the name
+    StringId instructor; // Interned, an instructor teaches several courses
     int credits;
     int maxCapacity;
-    std::vector<Student*> enrolledStudents;
+    HandleSet<Student> enrolledStudents;
 
 public:
     // Constructors
-    Course(std::string code = "", std::string name = "", std::string instructor = "", int credits = 0, int maxCapacity = 30);
-    Course(int id, std::string code, std::string name, std::string instructor, int credits, int maxCapacity);
+    Course(std::string_view code = "", std::string_view name = "", std::string_view instructor = "", int credits = 0, int maxCapacity = 30);
+    Course(int id, std::string_view code, std::string_view name, std::string_view instructor, int credits, int maxCapacity,
+           RecordResources resources = {});
 
     // Getters
     int getId() const;
-    std::string getCode() const;
-    std::string getName() const;
-    std::string getInstructor() const;
+    // Strings and the enrollment set are returned as views into the record, without copying;
+    // they stay valid until the record is changed or moved
+    std::string_view getCode() const;
+    std::string_view getName() const;
+    std::string_view getInstructor() const;
+    // Equal ids mean equal values, so grouping courses needs no string compares
+    StringId getNameId() const;
+    StringId getInstructorId() const;
     int getCredits() const;
     int getMaxCapacity() const;
     int getCurrentEnrollment() const;
-    std::vector<Student*> getEnrolledStudents() const;
+    const HandleSet<Student>& getEnrolledStudents() const;
 
     // Setters
     void setId(int id);
@@ -44,16 +59,17 @@ public:
     void setMaxCapacity(int maxCapacity);
 
     // Student management
-    bool addStudent(Student* student);
-    bool removeStudent(Student* student);
+    bool addStudent(StudentHandle student);
+    bool removeStudent(StudentHandle student);
     bool isFull() const;
-    bool hasStudent(Student* student) const;
+    bool hasStudent(StudentHandle student) const;
+    void reserveSeats(std::size_t count);
 
     // Display and other methods
-    void display() const;
-    void displayDetailed() const;
-    void displayEnrollmentList() const;
-    std::string toCSV() const; // For file output
+    void display(ReportWriter& out) const; // One row of the course table
+    void displayDetailed(ReportWriter& out) const;
+    void displayEnrollmentList(const SlotMap<Student>& students, ReportWriter& out) const;
+    void writeCSV(CsvWriter& writer) const; // For file output
 };
 
 #endif // COURSE_H
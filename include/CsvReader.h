@@ -0,0 +1,63 @@
+#ifndef CSV_READER_H
+#define CSV_READER_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// My read-only view of a whole file, memory mapped where the platform allows it
+// Rows are tokenized straight out of this buffer without copying lines around
+class MappedFile {
+private:
+    char* data;
+    std::size_t length;
+    bool mapped;
+    bool opened;
+    std::string fallback; // Used when mmap is not available
+
+public:
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool isOpen() const;
+    // The mapping is private and writable so quoted fields can be unescaped in place
+    char* begin() const { return data; }
+    char* end() const { return data + length; }
+    std::size_t size() const { return length; }
+};
+
+// A CSV tokenizer that hands out string_views into a byte range of a mapped file
+// Quoted fields (RFC 4180 style) are supported, so "Patna, Bihar" stays one field
+class CsvReader {
+private:
+    char* cursor;
+    char* limit;
+
+public:
+    CsvReader(char* begin, char* end);
+
+    // Counts the remaining lines so callers can reserve capacity up front
+    std::size_t countRows() const;
+
+    // Splits the next row into fields; the views stay valid while the file is mapped
+    bool nextRow(std::vector<std::string_view>& fields);
+
+    // Where the next row starts, e.g. the first data row after reading the header
+    char* position() const { return cursor; }
+};
+
+// Small helpers shared by the loaders
+namespace Csv {
+    // Cuts [begin, end) into at most parts ranges that each start at a row boundary
+    // Quote parity is tracked so newlines inside quoted fields never split a row
+    std::vector<char*> splitRows(char* begin, char* end, std::size_t parts);
+
+    // Both fail unless the whole text is one number
+    bool parseInt(std::string_view text, int& value);
+    bool parseFloat(std::string_view text, float& value);
+}
+
+#endif // CSV_READER_H
@@ -0,0 +1,42 @@
+#ifndef CSV_WRITER_H
+#define CSV_WRITER_H
+
+#include <cstddef>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+// The write side of my CSV handling: rows are formatted straight into one reusable
+// buffer with std::to_chars and handed to the stream in large blocks
+// Nothing is allocated per row and the stream is never flushed line by line
+class CsvWriter {
+private:
+    std::ostream& out;
+    std::vector<char> buffer;
+    std::size_t used = 0;
+    bool rowStarted = false;
+
+    char* reserve(std::size_t bytes);
+    void separator();
+
+public:
+    explicit CsvWriter(std::ostream& out, std::size_t bufferBytes = 1 << 20);
+    ~CsvWriter();
+    CsvWriter(const CsvWriter&) = delete;
+    CsvWriter& operator=(const CsvWriter&) = delete;
+
+    // Text fields are quoted only if they contain a comma, quote or line break
+    void field(std::string_view text);
+    void field(int value);
+    // Fixed notation with six decimals, the same text std::to_string produces
+    void field(float value);
+
+    void endRow();
+    // Writes a pre-formatted line as is, e.g. the header row
+    void line(std::string_view text);
+
+    // Hands everything buffered so far to the stream
+    void flush();
+};
+
+#endif // CSV_WRITER_H
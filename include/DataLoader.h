@@ -0,0 +1,34 @@
+#ifndef DATA_LOADER_H
+#define DATA_LOADER_H
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Student.h"
+#include "Course.h"
+#include "ThreadPool.h"
+#include "RecordArena.h"
+
+// Parsed rows of the three data files, kept in per-chunk vectors in file order
+// StudentManagement moves them into its stores and links the enrollments afterwards
+struct ParsedTables {
+    bool studentsFound = false;
+    bool coursesFound = false;
+    bool enrollmentsFound = false;
+    std::vector<std::vector<Student>> studentChunks;
+    std::vector<std::vector<Course>> courseChunks;
+    std::vector<std::vector<std::pair<int, int>>> enrollmentChunks; // studentId, courseId
+    // Owns the strings and enrollment sets of the parsed records; it moves into the store with them
+    std::unique_ptr<RecordArena> arena = std::make_unique<RecordArena>();
+};
+
+// My parallel startup loader
+// All three files are mapped at once and every file is cut into row-aligned byte ranges,
+// so students, courses and enrollments are parsed on the pool at the same time
+namespace DataLoader {
+    ParsedTables parseAll(const std::string& studentFile, const std::string& courseFile,
+                          const std::string& enrollmentFile, ThreadPool& pool);
+}
+
+#endif // DATA_LOADER_H
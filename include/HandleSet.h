@@ -0,0 +1,165 @@
+#ifndef HANDLE_SET_H
+#define HANDLE_SET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+#include "SlotMap.h"
+
+// One side of the student <-> course enrollment relation
+// I keep the handles packed in a vector for iteration and add a handle -> position table
+// once the set grows, so membership, insert and erase stay O(1) even for huge lecture courses
+// Erasing swaps the last handle into the hole, so iteration order is not insertion order
+// Both are flat vectors on the memory resource given at construction, so bulk loaded sets
+// can live in the record arena and dropping one never walks nodes; a copy goes back to
+// the normal heap
+template <typename T>
+class HandleSet {
+private:
+    // Small sets are scanned directly; the position map only pays off past this size
+    static constexpr std::size_t indexThreshold = 16;
+
+    // Open addressing with linear probing; the table stays at most half full
+    struct Slot {
+        std::uint64_t key;
+        std::uint32_t position;
+    };
+    static constexpr std::uint32_t emptySlot = UINT32_MAX;
+
+    std::pmr::vector<Handle<T>> items;
+    std::pmr::vector<Slot> slots;
+
+    static std::uint64_t keyOf(Handle<T> handle) {
+        return (static_cast<std::uint64_t>(handle.index) << 32) | handle.generation;
+    }
+
+    static std::size_t capacityFor(std::size_t count) {
+        std::size_t capacity = 64;
+        while (capacity < count * 2) {
+            capacity *= 2;
+        }
+        return capacity;
+    }
+
+    bool indexed() const { return items.size() > indexThreshold; }
+
+    std::size_t homeOf(std::uint64_t key) const {
+        std::uint64_t hash = key * 0x9E3779B97F4A7C15ull;
+        return static_cast<std::size_t>(hash ^ (hash >> 32)) & (slots.size() - 1);
+    }
+
+    // The slot holding the key, or the empty slot where it would go
+    std::size_t slotOf(std::uint64_t key) const {
+        std::size_t slot = homeOf(key);
+        while (slots[slot].position != emptySlot && slots[slot].key != key) {
+            slot = (slot + 1) & (slots.size() - 1);
+        }
+        return slot;
+    }
+
+    void setPosition(std::uint64_t key, std::uint32_t position) {
+        Slot& slot = slots[slotOf(key)];
+        slot.key = key;
+        slot.position = position;
+    }
+
+    // Empties the slot and shifts the entries after it back, so no probe chain is broken
+    void removeKey(std::uint64_t key) {
+        const std::size_t mask = slots.size() - 1;
+        std::size_t hole = slotOf(key);
+        for (std::size_t next = (hole + 1) & mask; slots[next].position != emptySlot; next = (next + 1) & mask) {
+            if (((next - homeOf(slots[next].key)) & mask) >= ((next - hole) & mask)) {
+                slots[hole] = slots[next];
+                hole = next;
+            }
+        }
+        slots[hole].position = emptySlot;
+    }
+
+    void rehash(std::size_t capacity) {
+        slots.assign(capacity, Slot{0, emptySlot});
+        for (std::uint32_t i = 0; i < items.size(); i++) {
+            setPosition(keyOf(items[i]), i);
+        }
+    }
+
+    // Position of a handle in the packed vector, or items.size() when it is not a member
+    std::size_t find(Handle<T> handle) const {
+        if (indexed()) {
+            const Slot& slot = slots[slotOf(keyOf(handle))];
+            return slot.position == emptySlot ? items.size() : slot.position;
+        }
+        for (std::size_t i = 0; i < items.size(); i++) {
+            if (items[i] == handle) {
+                return i;
+            }
+        }
+        return items.size();
+    }
+
+public:
+    using const_iterator = typename std::pmr::vector<Handle<T>>::const_iterator;
+
+    explicit HandleSet(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : items(resource), slots(resource) {}
+
+    void reserve(std::size_t count) {
+        items.reserve(count);
+        if (count > indexThreshold) {
+            slots.reserve(capacityFor(count));
+        }
+    }
+
+    void clear() {
+        items.clear();
+        slots.clear();
+    }
+
+    bool contains(Handle<T> handle) const { return find(handle) != items.size(); }
+
+    // Returns false when the handle was already a member
+    bool insert(Handle<T> handle) {
+        if (contains(handle)) {
+            return false;
+        }
+        items.push_back(handle);
+        if (items.size() == indexThreshold + 1) {
+            rehash(capacityFor(items.size()));
+        } else if (indexed() && items.size() * 2 > slots.size()) {
+            rehash(slots.size() * 2);
+        } else if (indexed()) {
+            setPosition(keyOf(handle), static_cast<std::uint32_t>(items.size() - 1));
+        }
+        return true;
+    }
+
+    // Returns false when the handle was not a member
+    bool erase(Handle<T> handle) {
+        std::size_t position = find(handle);
+        if (position == items.size()) {
+            return false;
+        }
+        if (indexed()) {
+            removeKey(keyOf(handle));
+            if (position != items.size() - 1) {
+                setPosition(keyOf(items.back()), static_cast<std::uint32_t>(position));
+            }
+        }
+        items[position] = items.back();
+        items.pop_back();
+        if (!indexed()) {
+            slots.clear();
+        }
+        return true;
+    }
+
+    std::size_t size() const { return items.size(); }
+    bool empty() const { return items.empty(); }
+
+    const Handle<T>& operator[](std::size_t position) const { return items[position]; }
+    const_iterator begin() const { return items.begin(); }
+    const_iterator end() const { return items.end(); }
+};
+
+#endif // HANDLE_SET_H
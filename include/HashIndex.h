@@ -0,0 +1,49 @@
+#ifndef HASH_INDEX_H
+#define HASH_INDEX_H
+
+#include <cstddef>
+#include <memory_resource>
+#include <unordered_map>
+#include "RecordArena.h"
+
+// A small key -> handle index that I keep next to the student and course stores
+// Lookups and uniqueness checks become O(1) instead of walking every record
+// The map nodes come from a pool of its own, so indexing a million records takes a few
+// dozen chunk allocations instead of one per record. Clearing or dropping the index still
+// walks the nodes, but hands the pool back whole instead of freeing them one by one
+template <typename Key, typename Value>
+class HashIndex {
+private:
+    using Map = std::pmr::unordered_map<Key, Value>;
+    std::pmr::unsynchronized_pool_resource nodes;
+    DroppableResource live{&nodes};
+    Map entries{&live};
+
+public:
+    HashIndex() = default;
+    HashIndex(const HashIndex&) = delete;
+    HashIndex& operator=(const HashIndex&) = delete;
+    ~HashIndex() { live.drop(); }
+
+    void reserve(std::size_t count) { entries.reserve(count); }
+
+    void clear() {
+        live.drop();
+        Map(&live).swap(entries);
+        nodes.release();
+        live.resume();
+    }
+    std::size_t size() const { return entries.size(); }
+
+    void insert(const Key& key, Value value) { entries[key] = value; }
+    void erase(const Key& key) { entries.erase(key); }
+    bool contains(const Key& key) const { return entries.find(key) != entries.end(); }
+
+    // Returns nullptr when the key is not indexed
+    const Value* find(const Key& key) const {
+        auto it = entries.find(key);
+        return it == entries.end() ? nullptr : &it->second;
+    }
+};
+
+#endif // HASH_INDEX_H
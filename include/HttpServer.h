@@ -0,0 +1,108 @@
+#ifndef HTTP_SERVER_H
+#define HTTP_SERVER_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "ThreadPool.h"
+
+// One parsed request; query string and form body parameters both end up in params
+struct HttpRequest {
+    std::string method;
+    std::string path;
+    std::map<std::string, std::string> params;
+    std::string body;
+    bool keepAlive = true;
+};
+
+struct HttpResponse {
+    int status = 200;
+    std::string body;
+    std::string contentType = "application/json";
+};
+
+// My embedded HTTP/1.1 server for the portal, listening on the loopback interface only
+// One thread runs a non-blocking epoll loop that accepts connections, reads requests and
+// writes responses; the handler runs on a worker pool, so a slow query never stalls the
+// other connections. Workers hand finished responses back through a queue and an eventfd.
+// Each connection has at most one request in flight, so pipelined requests are answered in order,
+// and it buffers at most one request's worth of input; the rest waits in the socket.
+// A client that shuts down its sending side still gets the answers to what it sent.
+// The event loop needs epoll and is only built on Linux; elsewhere start() fails
+class HttpServer {
+public:
+    using Handler = std::function<HttpResponse(const HttpRequest&)>;
+
+private:
+    struct Connection {
+        int fd = -1;
+        std::string input;
+        std::string output;
+        std::size_t written = 0;
+        bool busy = false;       // A request is with the workers
+        bool closeAfterWrite = false;
+        bool peerClosed = false; // Read returned 0, nothing more will arrive
+        bool wantsWrite = false;
+        std::uint32_t events = 0; // What the connection is registered for in epoll
+    };
+
+    struct Completion {
+        std::uint64_t connection;
+        std::string bytes;
+        bool close;
+    };
+
+    Handler handler;
+    // Reset first in the destructor, so no worker still touches the eventfd once it's closed
+    std::unique_ptr<ThreadPool> workers;
+    int listenFd = -1;
+    int epollFd = -1;
+    int wakeFd = -1; // eventfd: completions are ready or stop() was called
+    int boundPort = 0;
+
+    // Connections are keyed by an id that is never reused, so a late response for a
+    // closed connection cannot reach a new connection that got the same fd
+    std::unordered_map<std::uint64_t, Connection> connections;
+    std::uint64_t nextConnectionId = 2; // 0 and 1 tag the listen socket and the eventfd
+
+    std::mutex completionMutex;
+    std::vector<Completion> completions;
+    std::atomic<bool> stopping{false};
+
+    void acceptConnections();
+    void readFrom(std::uint64_t id);
+    void dispatchNext(std::uint64_t id);
+    // Dispatches what's buffered, then closes a connection the peer is done with or
+    // updates what it waits for
+    void advance(std::uint64_t id);
+    void writeTo(std::uint64_t id);
+    void closeConnection(std::uint64_t id);
+    void drainCompletions();
+    void watchWrites(std::uint64_t id, bool enabled);
+    void updateEvents(std::uint64_t id);
+
+public:
+    HttpServer(Handler handler, std::size_t workerCount = 0);
+    ~HttpServer();
+    HttpServer(const HttpServer&) = delete;
+    HttpServer& operator=(const HttpServer&) = delete;
+
+    // Binds 127.0.0.1:port, or a free port when port is 0; returns false with the reason in error
+    bool start(int port, std::string& error);
+    int getPort() const { return boundPort; }
+
+    // Serves until stop() is called; stop() is safe from another thread or a signal handler
+    void run();
+    void stop();
+
+    // Renders a response as HTTP/1.1 bytes
+    static std::string serialize(const HttpResponse& response, bool keepAlive);
+};
+
+#endif // HTTP_SERVER_H
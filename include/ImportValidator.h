@@ -0,0 +1,55 @@
+#ifndef IMPORT_VALIDATOR_H
+#define IMPORT_VALIDATOR_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class StudentManagement;
+class ThreadPool;
+
+// One parsed student row of an import; the text fields are views into the caller's data
+struct StudentRow {
+    std::size_t row;
+    std::string_view name;
+    int rollNo;
+    float grade;
+    float attendance;
+    std::string_view email;
+    std::string_view phone;
+    // How many earlier rows delete this roll number; once it was deleted it may exist in
+    // the store, and only adds between the same two deletes clash with each other
+    std::size_t deletesBefore = 0;
+};
+
+struct CourseRow {
+    std::size_t row;
+    std::string_view code;
+    std::string_view name;
+    std::string_view instructor;
+    int credits;
+    int capacity;
+};
+
+// One broken rule; a row gets one of these for every field that is wrong
+struct ValidationIssue {
+    std::size_t row;
+    std::string field;
+    std::string reason;
+};
+
+// My validation stage for bulk intakes
+// Every row is checked against the same rules as the menu (names, roll number, grade and
+// attendance 0-100, email and phone format, credits and capacity), against the store for
+// roll numbers and course codes that already exist, and against the other rows for roll
+// numbers and codes that appear twice. Rows are checked in ranges on the pool; for the
+// duplicate checks each worker owns a share of the keys by hash.
+// Nothing stops at the first problem: all issues come back, sorted by row.
+// The store is only read, so nothing may change it meanwhile
+namespace ImportValidator {
+    std::vector<ValidationIssue> validate(const StudentManagement& sm, const std::vector<StudentRow>& students,
+                                          const std::vector<CourseRow>& courses, ThreadPool& pool);
+}
+
+#endif // IMPORT_VALIDATOR_H
@@ -0,0 +1,76 @@
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Every mutation is written here as one compact line instead of rewriting the CSV files
+// The CSV files act as the snapshot and the journal holds what happened after it
+enum class JournalOp : char {
+    AddStudent = 'S',
+    UpdateStudent = 'U',
+    DeleteStudent = 'D',
+    AddCourse = 'C',
+    UpdateCourse = 'V',
+    DeleteCourse = 'X',
+    Enroll = 'E',
+    Drop = 'R'
+};
+
+struct JournalRecord {
+    JournalOp op;
+    std::vector<std::string> fields;
+};
+
+// Appends run on the thread that made the change; the writer thread only discards
+// records once the data files hold them, so both sides go through one mutex
+class Journal {
+private:
+    std::string path;
+    mutable std::mutex mutex;
+    int fd = -1;
+    std::size_t recordCount; // Records written since the last compaction
+    // Positions count every byte ever appended, so one taken before a discard still
+    // means the same record afterwards; the file starts at position discarded
+    std::uint64_t discarded = 0;
+    std::uint64_t fileBytes = 0;
+    std::atomic<bool> syncEveryAppend{false};
+
+    bool writeAll(int to, const char* data, std::size_t length);
+
+    static std::string escape(const std::string& field);
+    static std::string unescape(const std::string& field);
+
+public:
+    // The file is opened on the first append, so the data directory may not exist yet
+    explicit Journal(const std::string& path);
+    ~Journal();
+    Journal(const Journal&) = delete;
+    Journal& operator=(const Journal&) = delete;
+
+    // Appends one record with a single write, so it survives a crash of the program
+    // With syncing on it is also fsynced, so it survives a power loss too
+    // Returns false when the file could not be written
+    bool append(JournalOp op, const std::vector<std::string>& fields);
+    void setSyncEveryAppend(bool enabled) { syncEveryAppend = enabled; }
+
+    // Reads every complete record. A torn last line from a crash is ignored and cut off
+    // the file, so the next append starts on a line of its own
+    std::vector<JournalRecord> readAll();
+
+    // Where the next record will start; records before it are in the data files once
+    // a flush rendered after taking it is on disk
+    std::uint64_t position() const;
+
+    // Drops every record before position, once the data files hold them. Records
+    // appended after it stay, so a change made while a flush was on its way is kept
+    // Returns false when the file could not be rewritten; then nothing is dropped
+    bool discardBefore(std::uint64_t position);
+
+    std::size_t size() const;
+};
+
+#endif // JOURNAL_H
@@ -0,0 +1,51 @@
+#ifndef KERNELS_H
+#define KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// My vectorized scan kernels over the analytics columns
+// Each kernel has AVX2, SSE2 and scalar versions; the best one for the CPU is picked at runtime
+namespace Kernels {
+    enum class Compare { Less, LessEqual, Greater, GreaterEqual };
+
+    // Bucket counts for the grade letters (A-F) and attendance statuses
+    // (Excellent, Good, Satisfactory, Low), using the same cut-offs as the reports
+    struct RosterHistogram {
+        std::size_t grade[6] = {};
+        std::size_t attendance[4] = {};
+    };
+
+    // Sets bit i of mask when values[i] <op> threshold; mask gets (n + 63) / 64 words
+    void selectMask(const float* values, std::size_t n, Compare op, float threshold,
+                    std::vector<std::uint64_t>& mask);
+
+    // Counts the grade and attendance buckets for the whole roster in one pass
+    RosterHistogram rosterHistogram(const float* grades, const float* attendance, std::size_t n);
+
+    // Name of the instruction set the kernels run with ("avx2", "sse2" or "scalar")
+    const char* activeInstructionSet();
+
+    // Calls visit(i) for every set bit of a selection mask, in ascending order
+    template <typename Visit>
+    void forEachSelected(const std::vector<std::uint64_t>& mask, Visit visit) {
+        for (std::size_t w = 0; w < mask.size(); w++) {
+            std::uint64_t word = mask[w];
+            while (word) {
+#if defined(__GNUC__)
+                int bit = __builtin_ctzll(word);
+#else
+                int bit = 0;
+                while (!((word >> bit) & 1)) {
+                    bit++;
+                }
+#endif
+                visit(w * 64 + bit);
+                word &= word - 1;
+            }
+        }
+    }
+}
+
+#endif // KERNELS_H
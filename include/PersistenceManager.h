@@ -0,0 +1,61 @@
+#ifndef PERSISTENCE_MANAGER_H
+#define PERSISTENCE_MANAGER_H
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <string>
+
+// The data files that can go stale in memory, as bit flags so a change can touch several
+enum DataTable : unsigned {
+    StudentTable = 1,
+    CourseTable = 2,
+    EnrollmentTable = 4,
+    AllTables = 7
+};
+
+// When dirty tables are written back to the data files
+// Every change is in the journal right away, so this only trades restart replay time
+// against how often the full CSV files are rewritten
+struct FlushPolicy {
+    enum Mode { Immediate, EveryMillis, EveryOps, OnExit };
+    Mode mode = EveryOps;
+    std::size_t amount = 1000; // Milliseconds or operations, depending on the mode
+
+    // Parses "immediate", "exit", "ops:N" or "ms:N"; returns false for anything else
+    static bool parse(const std::string& text, FlushPolicy& policy);
+};
+
+// My group commit layer: changes only mark their tables dirty, and the dirty tables
+// are written together when the policy says so. Files are written to a temp file and
+// renamed over the old one, so a crash in the middle of a save never truncates them
+class PersistenceManager {
+private:
+    FlushPolicy policy;
+    unsigned dirty = 0;
+    std::size_t pendingOps = 0;
+    std::chrono::steady_clock::time_point lastFlush = std::chrono::steady_clock::now();
+
+public:
+    void setPolicy(const FlushPolicy& newPolicy) { policy = newPolicy; }
+
+    // Records one change to the given tables
+    void recordChange(unsigned tables);
+    void markDirty(unsigned tables) { dirty |= tables; }
+
+    bool isDirty(DataTable table) const { return (dirty & table) != 0; }
+    bool hasDirtyTables() const { return dirty != 0; }
+
+    // Whether the policy wants a flush now; OnExit never does, the exit path flushes itself
+    bool isFlushDue() const;
+
+    // Called after every dirty table was written
+    void markFlushed();
+
+    // Writes a file through path.tmp and a rename; the old file stays intact on any failure
+    // Returns true only once the file and the rename are both fsynced
+    static bool writeAtomically(const std::string& path, const std::function<void(std::ostream&)>& write);
+};
+
+#endif // PERSISTENCE_MANAGER_H
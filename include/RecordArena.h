@@ -0,0 +1,88 @@
+#ifndef RECORD_ARENA_H
+#define RECORD_ARENA_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+// Where a record allocates its strings and its enrollment set
+// Records built without an arena use the normal heap for both
+struct RecordResources {
+    std::pmr::memory_resource* strings = std::pmr::get_default_resource();
+    std::pmr::memory_resource* lists = std::pmr::get_default_resource();
+};
+
+// Passes allocations through to the heap and counts them, for the memory report
+class CountingResource : public std::pmr::memory_resource {
+private:
+    std::pmr::memory_resource* upstream;
+    std::atomic<std::size_t> blocks{0};
+    std::atomic<std::size_t> bytes{0};
+
+    void* do_allocate(std::size_t size, std::size_t alignment) override;
+    void do_deallocate(void* pointer, std::size_t size, std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+public:
+    explicit CountingResource(std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+
+    std::size_t liveBlocks() const { return blocks.load(); }
+    std::size_t liveBytes() const { return bytes.load(); }
+};
+
+// Passes allocations through, and frees too until drop() is called; after that frees
+// are skipped, since whatever sits below gives all of its memory back at once.
+// The record arena and the indexes put one in front of their pools
+class DroppableResource : public std::pmr::memory_resource {
+private:
+    std::pmr::memory_resource* upstream;
+    std::atomic<bool> dropping{false};
+
+    void* do_allocate(std::size_t size, std::size_t alignment) override;
+    void do_deallocate(void* pointer, std::size_t size, std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+public:
+    explicit DroppableResource(std::pmr::memory_resource* upstream) : upstream(upstream) {}
+
+    void drop() { dropping.store(true, std::memory_order_relaxed); }
+    // Frees pass through again, once the pool below has been released
+    void resume() { dropping.store(false, std::memory_order_relaxed); }
+};
+
+// My arena for bulk loaded records
+// Every parse chunk gets its own string pool, a monotonic buffer that hands out string
+// storage back to back and never frees it piece by piece, so the strings of one chunk sit
+// together in a few large blocks. Enrollment sets come from one shared pool of fixed size
+// blocks, which is thread-safe because the parallel linking step fills them from every thread.
+// Dropping the arena gives all of it back in a handful of frees, however many records it
+// held; it must outlive every record that was built with its resources.
+// Destroying the records themselves is still a pass over them, but after drop() it only
+// runs their destructors: neither the strings nor the enrollment sets free anything
+class RecordArena {
+private:
+    CountingResource heap;
+    std::pmr::synchronized_pool_resource pool{&heap};
+    DroppableResource lists{&pool};
+    std::vector<std::unique_ptr<std::pmr::monotonic_buffer_resource>> stringPools;
+
+public:
+    RecordArena() = default;
+    RecordArena(const RecordArena&) = delete;
+    RecordArena& operator=(const RecordArena&) = delete;
+
+    // A new string pool for one chunk; it may only be used by one thread at a time
+    // expectedBytes is a first block size hint, such as the size of the chunk's text
+    RecordResources newChunk(std::size_t expectedBytes = 0);
+
+    // Call before destroying the records built with this arena, which must follow soon:
+    // from then on nothing they give back is reused
+    void drop() { lists.drop(); }
+
+    std::size_t heapBlocks() const { return heap.liveBlocks(); }
+    std::size_t heapBytes() const { return heap.liveBytes(); }
+};
+
+#endif // RECORD_ARENA_H
@@ -0,0 +1,59 @@
+#ifndef REPORT_WRITER_H
+#define REPORT_WRITER_H
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// My renderer for the table views and reports
+// Like CsvWriter, rows are formatted straight into one large buffer, numbers with
+// std::to_chars and cells padded to a fixed width, and the stream only gets whole blocks,
+// so half a million rows are a few hundred writes instead of a flush per line.
+// Colours are only written when the output is a terminal (see UI::usesColors), so a
+// report piped to another program or written to a file is plain text
+class ReportWriter {
+private:
+    std::ostream& out;
+    std::vector<char> buffer;
+    std::size_t used = 0;
+    bool colors;
+
+    char* reserve(std::size_t bytes);
+    void drain();
+    void pad(std::size_t written, std::size_t width);
+
+public:
+    explicit ReportWriter(std::ostream& out, std::size_t bufferBytes = 1 << 20);
+    ~ReportWriter();
+    ReportWriter(const ReportWriter&) = delete;
+    ReportWriter& operator=(const ReportWriter&) = delete;
+
+    bool usesColors() const { return colors; }
+
+    // Plain text, written as is
+    ReportWriter& text(std::string_view value);
+    // A Color:: escape code, dropped when colours are off
+    ReportWriter& color(const std::string& code);
+
+    // Left aligned cells padded with spaces to at least width characters, like
+    // std::left << std::setw(width); numbers look the same as when streamed
+    ReportWriter& cell(std::string_view value, std::size_t width);
+    ReportWriter& cell(int value, std::size_t width);
+    ReportWriter& cell(std::size_t value, std::size_t width);
+    ReportWriter& cell(float value, std::size_t width);
+    // Right aligned, like std::right << std::setw(width); the double one in fixed notation
+    ReportWriter& rightCell(std::size_t value, std::size_t width);
+    ReportWriter& rightCell(double value, std::size_t width, int precision);
+
+    ReportWriter& endLine();
+
+    // The same banner as UI::printTitle
+    void title(std::string_view value);
+
+    // Hands everything buffered so far to the stream and flushes it
+    void flush();
+};
+
+#endif // REPORT_WRITER_H
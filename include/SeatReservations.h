@@ -0,0 +1,67 @@
+#ifndef SEAT_RESERVATIONS_H
+#define SEAT_RESERVATIONS_H
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Where a seat request stands
+enum class ReservationStatus {
+    Held,          // A seat is set aside and waits for confirm or cancel
+    Waitlisted,    // The course was full; the student is enrolled when a seat frees up
+    Full,          // The course was full and the caller did not want the waitlist
+    UnknownCourse,
+    Confirmed,
+    Cancelled
+};
+
+// A seat request, owned by the caller until it is confirmed or cancelled
+struct Reservation {
+    int rollNo = 0;
+    std::string code;
+    ReservationStatus status = ReservationStatus::Cancelled;
+};
+
+// My seat counters for registration rush hour
+// Every course has an atomic count of seats in use (enrolled plus held), and a seat is
+// taken with a compare-and-swap that never goes past the capacity. Thousands of requests
+// for the same course are decided without a lock, and the ones that lose are turned away
+// before they ever touch the course record. Only the waitlist has a mutex, and it is only
+// used once a course is full.
+// The table itself is changed only while the store is locked exclusively; everything
+// else may be called concurrently while it is locked shared
+class SeatReservations {
+public:
+    struct CourseSeats {
+        std::atomic<int> used{0};
+        int capacity = 0;
+        std::mutex waitlistMutex;
+        std::deque<int> waitlist; // Roll numbers, first come first served
+    };
+
+private:
+    std::unordered_map<std::string, std::unique_ptr<CourseSeats>> courses;
+
+public:
+    // Table maintenance, with the store locked exclusively
+    void track(const std::string& code, int capacity, int enrolled);
+    void untrack(const std::string& code);
+
+    CourseSeats* find(const std::string& code) const;
+
+    // Lock-free; false when the course has no seat left
+    static bool tryTake(CourseSeats& seats);
+    static void release(CourseSeats& seats);
+
+    // Waitlist, first come first served; a student is only on it once
+    static void joinWaitlist(CourseSeats& seats, int rollNo);
+    static bool leaveWaitlist(CourseSeats& seats, int rollNo);
+
+    // Takes a free seat for the first waitlisted student and returns their roll number
+    static bool promote(CourseSeats& seats, int& rollNo);
+};
+
+#endif // SEAT_RESERVATIONS_H
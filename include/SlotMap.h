@@ -0,0 +1,138 @@
+#ifndef SLOT_MAP_H
+#define SLOT_MAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// A generational handle into a SlotMap
+// The index picks the slot and the generation tells whether the slot was reused since
+template <typename T>
+struct Handle {
+    static constexpr std::uint32_t invalidIndex = UINT32_MAX;
+
+    std::uint32_t index = invalidIndex;
+    std::uint32_t generation = 0;
+
+    bool isValid() const { return index != invalidIndex; }
+    bool operator==(const Handle& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const Handle& other) const { return !(*this == other); }
+};
+
+// My slot map keeps the records packed in one vector for fast iteration,
+// while handles stay valid across growth and erasing of other records
+// Erasing swaps the last record into the hole, so it never shifts the whole vector
+template <typename T>
+class SlotMap {
+private:
+    struct Slot {
+        std::uint32_t dense;
+        std::uint32_t generation;
+    };
+
+    std::vector<T> items;                   // Packed records in iteration order
+    std::vector<std::uint32_t> denseToSlot; // Which slot owns each packed record
+    std::vector<Slot> slots;
+    std::vector<std::uint32_t> freeSlots;
+
+public:
+    using iterator = typename std::vector<T>::iterator;
+    using const_iterator = typename std::vector<T>::const_iterator;
+
+    template <typename... Args>
+    Handle<T> emplace(Args&&... args) {
+        std::uint32_t slotIndex;
+        if (!freeSlots.empty()) {
+            slotIndex = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            slotIndex = static_cast<std::uint32_t>(slots.size());
+            slots.push_back({0, 0});
+        }
+
+        items.emplace_back(std::forward<Args>(args)...);
+        denseToSlot.push_back(slotIndex);
+        slots[slotIndex].dense = static_cast<std::uint32_t>(items.size() - 1);
+        return Handle<T>{slotIndex, slots[slotIndex].generation};
+    }
+
+    bool erase(Handle<T> handle) {
+        if (!contains(handle)) {
+            return false;
+        }
+
+        std::uint32_t dense = slots[handle.index].dense;
+        std::uint32_t last = static_cast<std::uint32_t>(items.size() - 1);
+        if (dense != last) {
+            items[dense] = std::move(items[last]);
+            denseToSlot[dense] = denseToSlot[last];
+            slots[denseToSlot[dense]].dense = dense;
+        }
+        items.pop_back();
+        denseToSlot.pop_back();
+
+        // Bumping the generation makes every outstanding handle to this slot stale
+        slots[handle.index].generation++;
+        freeSlots.push_back(handle.index);
+        return true;
+    }
+
+    bool contains(Handle<T> handle) const {
+        return handle.index < slots.size() && slots[handle.index].generation == handle.generation;
+    }
+
+    T* get(Handle<T> handle) {
+        return contains(handle) ? &items[slots[handle.index].dense] : nullptr;
+    }
+
+    const T* get(Handle<T> handle) const {
+        return contains(handle) ? &items[slots[handle.index].dense] : nullptr;
+    }
+
+    // Packed position of a live record; only valid until the next erase
+    std::size_t indexOf(Handle<T> handle) const {
+        return slots[handle.index].dense;
+    }
+
+    // Handle of the record currently stored at a packed position
+    Handle<T> handleAt(std::size_t dense) const {
+        std::uint32_t slotIndex = denseToSlot[dense];
+        return Handle<T>{slotIndex, slots[slotIndex].generation};
+    }
+
+    void reserve(std::size_t count) {
+        items.reserve(count);
+        denseToSlot.reserve(count);
+        slots.reserve(count);
+    }
+
+    // Generations survive a clear so handles from before it can never alias new records
+    void clear() {
+        for (std::uint32_t slotIndex : denseToSlot) {
+            slots[slotIndex].generation++;
+            freeSlots.push_back(slotIndex);
+        }
+        items.clear();
+        denseToSlot.clear();
+    }
+
+    std::size_t size() const { return items.size(); }
+    bool empty() const { return items.empty(); }
+
+    T& operator[](std::size_t dense) { return items[dense]; }
+    const T& operator[](std::size_t dense) const { return items[dense]; }
+
+    iterator begin() { return items.begin(); }
+    iterator end() { return items.end(); }
+    const_iterator begin() const { return items.begin(); }
+    const_iterator end() const { return items.end(); }
+};
+
+// Handles used for the links between students and courses
+class Student;
+class Course;
+using StudentHandle = Handle<Student>;
+using CourseHandle = Handle<Course>;
+
+#endif // SLOT_MAP_H
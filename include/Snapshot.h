@@ -0,0 +1,30 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <string>
+#include "DataLoader.h"
+#include "SlotMap.h"
+
+// My binary snapshot format for fast restarts
+// Layout (all sections 8-byte aligned, little endian):
+//   header   - magic, version, byte order tag and the row counts
+//   students - id[], rollNo[], grade[], attendance[], then name/email/phone/address string refs
+//   courses  - id[], credits[], maxCapacity[], then code/name/instructor string refs
+//   enrollments - studentId[] and courseId[] as packed int arrays
+//   string heap - the bytes every string ref points into
+// A string ref is an (offset, length) pair of uint32 into the heap
+namespace Snapshot {
+    const std::uint32_t version = 1;
+
+    // Builds the whole file in memory, e.g. to hand it to the background writer
+    bool encode(const SlotMap<Student>& students, const SlotMap<Course>& courses, std::string& bytes);
+
+    // Writes to a temporary file first and renames it over path, so readers never see half a file
+    bool write(const std::string& path, const SlotMap<Student>& students, const SlotMap<Course>& courses);
+
+    // Maps the file and fills tables with one chunk per table
+    // Returns false (and leaves tables empty) when the file is missing, corrupt or from another version
+    bool read(const std::string& path, ParsedTables& tables);
+}
+
+#endif // SNAPSHOT_H
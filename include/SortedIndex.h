@@ -0,0 +1,109 @@
+#ifndef SORTED_INDEX_H
+#define SORTED_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory_resource>
+#include <set>
+#include <utility>
+#include <vector>
+#include "RecordArena.h"
+#include "SlotMap.h"
+
+// An ordered secondary index over students, maintained on every insert, update and delete
+// Sorted display is a walk of the index and range queries start with a binary search,
+// so the student store itself never has to be reordered
+template <typename Key, typename Compare = std::less<Key>>
+class SortedIndex {
+private:
+    struct Entry {
+        Key key;
+        StudentHandle handle;
+    };
+
+    // Equal keys are ordered by slot so every entry has a unique, deterministic place
+    struct EntryOrder {
+        Compare compare;
+        bool operator()(const Entry& a, const Entry& b) const {
+            if (compare(a.key, b.key)) return true;
+            if (compare(b.key, a.key)) return false;
+            return a.handle.index < b.handle.index;
+        }
+    };
+
+    // The entry set and the positions allocate from one pool, like HashIndex, and clearing
+    // or dropping the index hands the pool back whole. Only the set is a node container
+    // that has to be walked; slots are dense, so the positions are a vector by slot that
+    // holds entries.end() for slots that are not indexed
+    using EntrySet = std::pmr::set<Entry, EntryOrder>;
+    using Positions = std::pmr::vector<typename EntrySet::const_iterator>;
+    std::pmr::unsynchronized_pool_resource nodes;
+    DroppableResource live{&nodes};
+    EntrySet entries{&live};
+    Positions positions{&live};
+
+public:
+    SortedIndex() = default;
+    SortedIndex(const SortedIndex&) = delete;
+    SortedIndex& operator=(const SortedIndex&) = delete;
+    ~SortedIndex() { live.drop(); }
+
+    void insert(StudentHandle handle, Key key) {
+        erase(handle);
+        if (handle.index >= positions.size()) {
+            positions.resize(handle.index + 1, entries.end());
+        }
+        positions[handle.index] = entries.insert({std::move(key), handle}).first;
+    }
+
+    void update(StudentHandle handle, Key key) { insert(handle, std::move(key)); }
+
+    void erase(StudentHandle handle) {
+        if (handle.index < positions.size() && positions[handle.index] != entries.end()) {
+            entries.erase(positions[handle.index]);
+            positions[handle.index] = entries.end();
+        }
+    }
+
+    void clear() {
+        live.drop();
+        EntrySet(&live).swap(entries);
+        Positions(&live).swap(positions);
+        nodes.release();
+        live.resume();
+    }
+
+    std::size_t size() const { return entries.size(); }
+
+    // Visits every handle in index order
+    template <typename Visit>
+    void forEach(Visit visit) const {
+        for (const auto& entry : entries) {
+            visit(entry.handle);
+        }
+    }
+
+    // Visits the handles whose keys lie between first and last (inclusive), in index order
+    template <typename Visit>
+    void forEachInRange(const Key& first, const Key& last, Visit visit) const {
+        const Compare& compare = entries.key_comp().compare;
+        for (auto it = entries.lower_bound({first, StudentHandle{0, 0}}); it != entries.end(); ++it) {
+            if (compare(last, it->key)) {
+                break;
+            }
+            visit(it->handle);
+        }
+    }
+
+    // The first k handles in index order
+    std::vector<StudentHandle> first(std::size_t k) const {
+        std::vector<StudentHandle> result;
+        for (auto it = entries.begin(); it != entries.end() && result.size() < k; ++it) {
+            result.push_back(it->handle);
+        }
+        return result;
+    }
+};
+
+#endif // SORTED_INDEX_H
@@ -0,0 +1,68 @@
+#ifndef STRING_POOL_H
+#define STRING_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+
+// A compact reference to an interned string; 0 is always the empty string
+using StringId = std::uint32_t;
+
+struct StringPoolStats {
+    std::size_t distinct = 0;   // Stored values, not counting the empty string
+    std::size_t textBytes = 0;  // Characters of the stored values
+    std::size_t indexBytes = 0; // About what the id table and the lookup map take on top
+};
+
+// My interning dictionary for columns whose values repeat across many records
+// Each distinct value is stored once and records keep its 4 byte id, so two records
+// hold the same value exactly when their ids are equal.
+// Values are split over shards by hash, so parse threads interning at the same time
+// rarely wait on each other. Reading a value back takes no lock: its slot was written
+// before the id was handed out and never changes afterwards.
+// Nothing is ever removed, so a value that is edited away stays in the pool until exit
+class StringPool {
+private:
+    static constexpr std::size_t ShardBits = 4;
+    static constexpr std::size_t ShardCount = std::size_t(1) << ShardBits;
+    // Segment k of a shard holds 64 << k values, so stored slots never move; the segments
+    // together cover every index that still fits in an id next to the shard bits
+    static constexpr std::size_t SegmentCount = 32 - ShardBits - 6;
+
+    struct Shard {
+        std::mutex mutex;
+        std::pmr::monotonic_buffer_resource text;
+        std::unordered_map<std::string_view, StringId> ids;
+        std::unique_ptr<std::string_view[]> segments[SegmentCount];
+        std::uint32_t size = 0;
+        std::size_t textBytes = 0;
+    };
+
+    Shard shards[ShardCount];
+
+    static void locate(std::uint32_t index, std::size_t& segment, std::size_t& offset);
+
+public:
+    StringPool() = default;
+    StringPool(const StringPool&) = delete;
+    StringPool& operator=(const StringPool&) = delete;
+
+    // Returns the id of the value, storing it first if it's new; safe from any thread
+    StringId intern(std::string_view value);
+
+    // The stored value; the view stays valid for the life of the program
+    std::string_view text(StringId id) const;
+
+    StringPoolStats stats();
+
+    // The pools of the interned columns
+    static StringPool& addresses();
+    static StringPool& courseNames();
+    static StringPool& instructors();
+};
+
+#endif // STRING_POOL_H
@@ -4,40 +4,52 @@
 #include <string>
 #include <iostream>
 #include <iomanip>
+#include <memory_resource>
+#include <string_view>
 #include <vector>
+#include "SlotMap.h"
+#include "HandleSet.h"
+#include "RecordArena.h"
+#include "StringPool.h"
 
 // My custom Student class for managing student data
 // I'm using forward declaration here to avoid circular dependencies
 class Course;
+class CsvWriter;
+class ReportWriter;
 
 class Student {
 private:
     int id;
-    std::string name;
+    // The strings use the resource the record was built with, the arena for bulk loads
+    std::pmr::string name;
     int rollNo;
     float grade;
     float attendance;
-    std::string email;
-    std::string phone;
-    std::string address;
-    std::vector<Course*> enrolledCourses;
+    std::pmr::string email;
+    std::pmr::string phone;
+    StringId address; // Interned, many students share a hostel or city
+    HandleSet<Course> enrolledCourses;
 
 public:
     // Constructors
-    Student(std::string n = "", int r = 0, float g = 0.0, float a = 0.0);
-    Student(int id, std::string n, int r, float g, float a, std::string email = "", 
-            std::string phone = "", std::string address = "");
+    Student(std::string_view n = "", int r = 0, float g = 0.0, float a = 0.0);
+    Student(int id, std::string_view n, int r, float g, float a, std::string_view email = "", 
+            std::string_view phone = "", std::string_view address = "", RecordResources resources = {});
 
     // Getters
     int getId() const;
-    std::string getName() const;
+    // Strings and the enrollment set are returned as views into the record, without copying;
+    // they stay valid until the record is changed or moved
+    std::string_view getName() const;
     int getRollNo() const;
     float getGrade() const;
     float getAttendance() const;
-    std::string getEmail() const;
-    std::string getPhone() const;
-    std::string getAddress() const;
-    std::vector<Course*> getEnrolledCourses() const;
+    std::string_view getEmail() const;
+    std::string_view getPhone() const;
+    std::string_view getAddress() const;
+    StringId getAddressId() const; // Equal ids mean equal addresses
+    const HandleSet<Course>& getEnrolledCourses() const;
 
     // Setters
     void setId(int id);
@@ -50,15 +62,16 @@ public:
     void setAddress(std::string address);
 
     // Course management
-    void enrollCourse(Course* course);
-    void dropCourse(Course* course);
-    bool isEnrolledIn(Course* course) const;
+    void enrollCourse(CourseHandle course);
+    void dropCourse(CourseHandle course);
+    bool isEnrolledIn(CourseHandle course) const;
+    void reserveCourses(std::size_t count);
 
     // Display and other methods
-    void display() const;
-    void displayDetailed() const;
+    void display(ReportWriter& out) const; // One row of the student tables
+    void displayDetailed(const SlotMap<Course>& courses, ReportWriter& out) const;
     void displayAttendance() const;
-    std::string toCSV() const; // For file output
+    void writeCSV(CsvWriter& writer) const; // For file output
 };
 
 #endif // STUDENT_H
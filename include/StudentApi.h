@@ -0,0 +1,22 @@
+#ifndef STUDENT_API_H
+#define STUDENT_API_H
+
+#include "HttpServer.h"
+
+class ConcurrentStudentManagement;
+
+// The JSON endpoints of the server mode, so the portal no longer has to scrape the console
+//   GET    /students/{rollNo}                 one student with the codes of their courses
+//   GET    /courses/{code}                    one course with its roster
+//   POST   /enrollments      roll, code       enroll (201), 404 unknown, 409 full or enrolled
+//   DELETE /enrollments      roll, code       drop
+//   GET    /reports/top?count=N               top performers, 5 by default
+//   GET    /reports/grades?min=&max=          students in a grade range, highest first
+//   GET    /reports/attendance?min=           students at or above an attendance percentage
+//   GET    /reports/histogram                 grade letter and attendance bucket counts
+// Parameters come from the query string or a form encoded body
+namespace StudentApi {
+    HttpResponse handle(ConcurrentStudentManagement& store, const HttpRequest& request);
+}
+
+#endif // STUDENT_API_H
@@ -9,48 +9,184 @@
 #include <map>
 #include "Student.h"
 #include "Course.h"
+#include "HashIndex.h"
+#include "SlotMap.h"
+#include "Journal.h"
+#include "ThreadPool.h"
+#include "DataLoader.h"
+#include "AnalyticsStore.h"
+#include "Kernels.h"
+#include "TopK.h"
+#include "SortedIndex.h"
+#include "PersistenceManager.h"
+#include "AsyncWriter.h"
+#include "ReportWriter.h"
+#include <functional>
+#include <mutex>
+#include <unordered_map>
 
 class StudentManagement {
 private:
-    std::vector<Student> students;
-    std::vector<Course> courses;
+    // Strings and enrollment sets of the loaded records; declared first so it outlives them
+    std::unique_ptr<RecordArena> arena;
+    
+    // Slot maps so the handles stored in enrollment links survive growth and deletes
+    SlotMap<Student> students;
+    SlotMap<Course> courses;
     const std::string studentFile = "data/students.csv";
     const std::string courseFile = "data/courses.csv";
     const std::string enrollmentFile = "data/enrollments.csv";
+    const std::string journalFile = "data/journal.log";
+    const std::string snapshotFile = "data/store.snap";
+    
+    // Mutations are appended here and folded into the data files when they are flushed
+    Journal journal{journalFile};
+    PersistenceManager persistence;
+    
+    // Enrollments from several threads (ConcurrentStudentManagement) log at the same time;
+    // this keeps the journal records in the order the changes were made
+    mutable std::mutex logMutex;
+    bool inlineFlushes = true;
+    
+    // Set between beginBulkUpdate and endBulkUpdate, when nothing is journaled
+    bool bulkUpdate = false;
+    bool indexesBeforeBulk = true;
+    
+    // Grade, attendance and roll number columns for the reports, aligned with students
+    AnalyticsStore analytics;
+    
+    // Ordered secondary indexes kept up to date on every change, so sorted views,
+    // top-K and grade ranges are walks of an index instead of sorts of the store
+    SortedIndex<std::string> nameIndex;
+    SortedIndex<float, std::greater<float>> gradeIndex;
+    bool secondaryIndexesEnabled = true;
+    void rebuildSecondaryIndexes();
+    void indexStudent(StudentHandle handle);
+    void unindexStudent(StudentHandle handle);
+    
+    // Roll number -> student handle, course code -> course handle
+    HashIndex<int, StudentHandle> rollIndex;
+    HashIndex<std::string, CourseHandle> codeIndex;
+    
+    // Index maintenance
+    void rebuildStudentIndex();
+    void rebuildCourseIndex();
     
     // Helper methods
-    bool isRollNoUnique(int rollNo) const;
-    bool isCourseCodeUnique(const std::string& code) const;
+    StudentHandle findStudentHandle(int rollNo) const;
+    CourseHandle findCourseHandle(const std::string& code) const;
+    void eraseStudent(StudentHandle handle);
+    void eraseCourse(CourseHandle handle);
+    void linkEnrollment(StudentHandle student, CourseHandle course);
+    void printStudentTableHeader(ReportWriter& out) const;
+    void printStudentTableFooter(ReportWriter& out, const std::string& label, std::size_t count) const;
+    
+    // Links kept on the student side after a full course refused the seat (old data files
+    // allowed this). While there are any, deleting a course has to check every student
+    std::size_t unseatedLinks = 0;
+    
+    // Journal operations
+    void logMutation(JournalOp op, const std::vector<std::string>& fields);
+    void replayJournal();
+    void applyJournalRecord(const JournalRecord& record,
+                            std::unordered_map<int, StudentHandle>& studentIds,
+                            std::unordered_map<int, CourseHandle>& courseIds);
     int generateStudentId() const;
     int generateCourseId() const;
     
+    // Highest ids in use, rescanned only after a load or after the highest one was deleted
+    mutable int maxStudentId = 0;
+    mutable int maxCourseId = 0;
+    mutable bool studentIdsStale = true;
+    mutable bool courseIdsStale = true;
+    
     // File operations
-    void saveStudentsToFile() const;
-    void saveCoursesToFile() const;
-    void saveEnrollmentsToFile() const;
-    void loadStudentsFromFile();
-    void loadCoursesFromFile();
-    void loadEnrollmentsFromFile();
+    void saveStudentsToFile(std::ostream& outFile) const;
+    void saveCoursesToFile(std::ostream& outFile) const;
+    void saveEnrollmentsToFile(std::ostream& outFile) const;
+    void loadAllFiles();
+    bool isSnapshotFresh() const;
+    void installTables(ParsedTables& tables, ThreadPool& pool);
+    void linkEnrollments(const std::vector<std::vector<std::pair<int, int>>>& chunks, ThreadPool& pool);
+    
+    // Journal appends and data file rewrites run on this thread, in order
+    // Declared last so it is destroyed first and drains its queue while the journal still exists
+    AsyncWriter writer;
 
 public:
     // Constructor
     StudentManagement();
+    // Drops the arena before the records go, so tearing them down frees nothing one by one
+    ~StudentManagement();
+    
+    // Read-only access to the stores, used to resolve enrollment handles
+    const SlotMap<Student>& getStudents() const;
+    const SlotMap<Course>& getCourses() const;
+    
+    // Writes the dirty tables now, or only when the flush policy says so
+    void flushDataFiles();
+    void flushIfDue();
+    void setFlushPolicy(const FlushPolicy& policy);
+    
+    // With inline flushes off a change never writes the data files itself; the caller
+    // checks isFlushDue and calls flushIfDue when no other thread is using the store
+    void setInlineFlushes(bool enabled);
+    bool isFlushDue() const;
+    
+    // Blocks until the background writer has finished everything queued so far
+    void waitForPendingWrites();
+    
+    // Writes the dirty tables and waits for them; false when any background write since
+    // the last check failed, e.g. a full disk
+    bool flushAndWait();
+    WriterMetrics getWriterMetrics() const;
+    
+    // Rewrites every data file and the binary snapshot and empties the journal
+    void compactDataFiles();
+    
+    // Conversion between the CSV files and a binary snapshot
+    bool exportSnapshot(const std::string& path) const;
+    bool importSnapshot(const std::string& path);
     
     // Student management
     void addStudent();
-    void displayAllStudents() const;
+    void displayAllStudents(std::ostream& out = std::cout) const;
     Student* searchStudentByRoll(int rollNo);
     const Student* searchStudentByRoll(int rollNo) const;
     void updateStudent(int rollNo);
     void deleteStudent(int rollNo);
+    std::size_t deleteStudents(const std::vector<int>& rollNos);
     
     // Course management
     void addCourse();
-    void displayAllCourses() const;
+    void displayAllCourses(std::ostream& out = std::cout) const;
     Course* searchCourseByCode(const std::string& code);
     const Course* searchCourseByCode(const std::string& code) const;
+    
+    // Whether a roll number or course code is still free; the import validation checks
+    // whole batches with these from several threads, so they only read the indexes
+    bool isRollNoUnique(int rollNo) const;
+    bool isCourseCodeUnique(const std::string& code) const;
     void updateCourse(const std::string& code);
     void deleteCourse(const std::string& code);
+    std::size_t deleteCourses(const std::vector<std::string>& codes);
+    
+    // Non-interactive operations for the batch mode; each one validates its input
+    // and returns false with the reason in error instead of prompting
+    bool insertStudent(const std::string& name, int rollNo, float grade, float attendance,
+                       const std::string& email, const std::string& phone, const std::string& address,
+                       std::string& error);
+    bool insertCourse(const std::string& code, const std::string& name, const std::string& instructor,
+                      int credits, int maxCapacity, std::string& error);
+    bool enroll(int rollNo, const std::string& code, std::string& error);
+    bool drop(int rollNo, const std::string& code, std::string& error);
+    bool setGrade(int rollNo, float grade, std::string& error);
+    
+    // A bulk update skips the journal and the secondary indexes; ending it rebuilds
+    // the indexes and writes every data file once. Nothing of the update is journaled,
+    // so when endBulkUpdate returns false none of it is on disk
+    void beginBulkUpdate();
+    bool endBulkUpdate();
     
     // Enrollment management
     void enrollStudentInCourse();
@@ -59,14 +195,25 @@ public:
     void displayCourseEnrollment(const std::string& code) const;
     
     // Statistics and reports
-    void generateGradeReport() const;
-    void generateAttendanceReport() const;
+    // The long listings can go to any stream, e.g. a file; colours only reach a terminal
+    void generateGradeReport(std::ostream& out = std::cout) const;
+    void generateAttendanceReport(std::ostream& out = std::cout) const;
     void showTopPerformers(int count = 5) const;
+    Kernels::RosterHistogram getRosterHistogram() const;
+    // Memory of the interned columns against keeping a copy in every record
+    void printMemoryReport(std::ostream& out = std::cout) const;
+    void setSecondaryIndexesEnabled(bool enabled);
     
     // Sorting and filtering
-    void sortStudentsByName();
-    void sortStudentsByGrade();
+    void sortStudentsByName() const;
+    void sortStudentsByGrade() const;
     void filterStudentsByAttendance(float minAttendance) const;
+    void filterStudentsByGradeRange(float minGrade, float maxGrade) const;
+    
+    // The same queries as data; the pointers stay valid until the store is next changed
+    std::vector<const Student*> findTopPerformers(int count) const;
+    std::vector<const Student*> findStudentsByGradeRange(float minGrade, float maxGrade) const;
+    std::vector<const Student*> findStudentsByAttendance(float minAttendance) const;
 };
 
 #endif // STUDENT_MANAGEMENT_H
@@ -0,0 +1,14 @@
+#ifndef TOP_K_H
+#define TOP_K_H
+
+#include <cstddef>
+#include <vector>
+
+// Top-K selection over a column without copying or fully sorting the records
+namespace TopK {
+    // Rows of the k largest values, best first; equal values keep the lower row first
+    // Runs in O(n + k log k) using nth_element followed by a sort of the winners
+    std::vector<std::size_t> largest(const std::vector<float>& values, std::size_t k);
+}
+
+#endif // TOP_K_H
@@ -4,7 +4,7 @@
 #include <string>
 #include <iostream>
 #include <limits>
-#include <regex>
+#include <string_view>
 
 // I added these ANSI color codes to make my CLI interface more attractive
 // The colors help distinguish between different types of information and make the UI more user-friendly
@@ -31,6 +31,9 @@ namespace UI {
     // Creates horizontal separator lines to divide sections of output
     void printSeparator(char symbol = '-', int length = 50);
     
+    // The status lines below go to stderr, so they never end up in a report that is
+    // piped or redirected from stdout
+
     // Shows success messages in green for positive feedback
     void printSuccess(const std::string& message);
     
@@ -45,6 +48,10 @@ namespace UI {
     
     // Wait for user input to continue
     void pressEnterToContinue();
+
+    // True when out is std::cout or std::cerr and that stream goes to a terminal;
+    // colours are only written then, so redirected output stays plain text
+    bool usesColors(const std::ostream& out);
 }
 
 // Input validation utilities
@@ -70,10 +77,10 @@ namespace Validation {
     bool isAlphanumeric(const std::string& str);
 
     // Check if string is a valid email address
-    bool isValidEmail(const std::string& email);
+    bool isValidEmail(std::string_view email);
 
     // Check if string is a valid phone number
-    bool isValidPhone(const std::string& phone);
+    bool isValidPhone(std::string_view phone);
 }
 
 #endif // UTILS_H
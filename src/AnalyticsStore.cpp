@@ -0,0 +1,36 @@
+#include "../include/AnalyticsStore.h"
+#include "../include/Student.h"
+
+void AnalyticsStore::rebuild(const SlotMap<Student>& students) {
+    gradeColumn.clear();
+    attendanceColumn.clear();
+    rollNoColumn.clear();
+    gradeColumn.reserve(students.size());
+    attendanceColumn.reserve(students.size());
+    rollNoColumn.reserve(students.size());
+    for (const auto& student : students) {
+        append(student);
+    }
+}
+
+void AnalyticsStore::append(const Student& student) {
+    gradeColumn.push_back(student.getGrade());
+    attendanceColumn.push_back(student.getAttendance());
+    rollNoColumn.push_back(student.getRollNo());
+}
+
+void AnalyticsStore::update(std::size_t row, const Student& student) {
+    gradeColumn[row] = student.getGrade();
+    attendanceColumn[row] = student.getAttendance();
+    rollNoColumn[row] = student.getRollNo();
+}
+
+// Same swap-and-pop the SlotMap does, so the rows stay aligned with it
+void AnalyticsStore::swapRemove(std::size_t row) {
+    gradeColumn[row] = gradeColumn.back();
+    attendanceColumn[row] = attendanceColumn.back();
+    rollNoColumn[row] = rollNoColumn.back();
+    gradeColumn.pop_back();
+    attendanceColumn.pop_back();
+    rollNoColumn.pop_back();
+}
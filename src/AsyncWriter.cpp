@@ -0,0 +1,100 @@
+#include "../include/AsyncWriter.h"
+
+AsyncWriter::AsyncWriter(std::size_t capacity) : ring(capacity) {
+    worker = std::thread(&AsyncWriter::writerLoop, this);
+}
+
+AsyncWriter::~AsyncWriter() {
+    {
+        std::lock_guard<std::mutex> lock(parkMutex);
+        stopping = true;
+    }
+    parkCondition.notify_one();
+    worker.join();
+}
+
+void AsyncWriter::submit(std::function<bool()> task) {
+    std::size_t slot = tail.load(std::memory_order_relaxed);
+
+    // Backpressure: with the ring full the producer waits for the writer to catch up
+    while (slot - head.load() >= ring.size()) {
+        std::this_thread::yield();
+    }
+
+    ring[slot % ring.size()] = Task{std::move(task), std::chrono::steady_clock::now()};
+    tail.store(slot + 1);
+
+    std::size_t depth = slot + 1 - head.load();
+    if (depth > maxDepth.load(std::memory_order_relaxed)) {
+        maxDepth.store(depth, std::memory_order_relaxed);
+    }
+
+    // The writer announces itself before its last emptiness check, so either it sees
+    // this task or we see it sleeping and wake it up
+    if (sleeping.load()) {
+        std::lock_guard<std::mutex> lock(parkMutex);
+        parkCondition.notify_one();
+    }
+}
+
+void AsyncWriter::writerLoop() {
+    while (true) {
+        std::size_t slot = head.load(std::memory_order_relaxed);
+        if (slot == tail.load()) {
+            std::unique_lock<std::mutex> lock(parkMutex);
+            sleeping = true;
+            parkCondition.wait(lock, [this]() { return stopping.load() || !isEmpty(); });
+            sleeping = false;
+            if (stopping && isEmpty()) {
+                return;
+            }
+            continue;
+        }
+
+        Task task = std::move(ring[slot % ring.size()]);
+        ring[slot % ring.size()] = Task{};
+        if (!task.run()) {
+            failures++;
+            unreportedFailures++;
+        }
+
+        auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - task.queuedAt).count();
+        lastLatencyUs.store(latency, std::memory_order_relaxed);
+        totalLatencyUs.fetch_add(latency, std::memory_order_relaxed);
+        if (latency > maxLatencyUs.load(std::memory_order_relaxed)) {
+            maxLatencyUs.store(latency, std::memory_order_relaxed);
+        }
+
+        // The slot is only released once the task has finished, so waitForPending()
+        // returning really means the bytes are on disk
+        {
+            std::lock_guard<std::mutex> lock(doneMutex);
+            head.store(slot + 1);
+        }
+        doneCondition.notify_all();
+    }
+}
+
+void AsyncWriter::waitForPending() {
+    std::size_t target = tail.load();
+    std::unique_lock<std::mutex> lock(doneMutex);
+    doneCondition.wait(lock, [this, target]() { return head.load() >= target; });
+}
+
+bool AsyncWriter::takeFailure() {
+    return unreportedFailures.exchange(0) > 0;
+}
+
+WriterMetrics AsyncWriter::metrics() const {
+    WriterMetrics result;
+    std::size_t done = head.load();
+    result.queueDepth = tail.load() - done;
+    result.maxQueueDepth = maxDepth.load();
+    result.completed = done;
+    result.failed = failures.load();
+    result.lastLatencyMs = lastLatencyUs.load() / 1000.0;
+    result.averageLatencyMs = done > 0 ? totalLatencyUs.load() / 1000.0 / done : 0;
+    result.maxLatencyMs = maxLatencyUs.load() / 1000.0;
+    return result;
+}
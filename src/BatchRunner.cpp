@@ -0,0 +1,254 @@
+#include "../include/BatchRunner.h"
+#include "../include/StudentManagement.h"
+#include "../include/CsvReader.h"
+#include "../include/Utils.h"
+#include "../include/ImportValidator.h"
+#include "../include/ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <iterator>
+#include <unordered_map>
+
+enum class BatchCommandType { AddStudent, AddCourse, Enroll, Drop, UpdateGrade, DeleteStudent };
+
+// One parsed command line; only the fields its type uses are filled in
+struct BatchCommand {
+    BatchCommandType type;
+    std::size_t line;
+    int rollNo = 0;
+    int credits = 0;
+    int capacity = 0;
+    float grade = 0;
+    float attendance = 0;
+    std::string text[4]; // name/email/phone/address, or code/name/instructor
+    std::string parseError; // Set when the row was rejected in the first pass
+    std::vector<ValidationIssue> issues; // Broken rules found by the validation pass
+};
+
+// Minimum number of fields after the command name
+struct BatchCommandSpec {
+    const char* name;
+    BatchCommandType type;
+    std::size_t fields;
+};
+
+static const BatchCommandSpec specs[] = {
+    {"add-student", BatchCommandType::AddStudent, 4},
+    {"add-course", BatchCommandType::AddCourse, 5},
+    {"enroll", BatchCommandType::Enroll, 2},
+    {"drop", BatchCommandType::Drop, 2},
+    {"update-grade", BatchCommandType::UpdateGrade, 2},
+    {"delete-student", BatchCommandType::DeleteStudent, 1},
+};
+
+// Checks the shape and number formats of one row; the store checks the rest when applying
+static bool parseCommand(const std::vector<std::string_view>& fields, BatchCommand& command, std::string& error) {
+    const BatchCommandSpec* spec = nullptr;
+    for (const auto& candidate : specs) {
+        if (fields[0] == candidate.name) {
+            spec = &candidate;
+        }
+    }
+    if (!spec) {
+        error = "unknown command '" + std::string(fields[0]) + "'";
+        return false;
+    }
+    if (fields.size() < spec->fields + 1) {
+        error = std::string(spec->name) + " needs " + std::to_string(spec->fields) + " fields";
+        return false;
+    }
+
+    command.type = spec->type;
+    bool ok = true;
+    switch (spec->type) {
+        case BatchCommandType::AddStudent:
+            command.text[0] = std::string(fields[1]);
+            ok = Csv::parseInt(fields[2], command.rollNo) &&
+                 Csv::parseFloat(fields[3], command.grade) &&
+                 Csv::parseFloat(fields[4], command.attendance);
+            if (fields.size() > 5) command.text[1] = std::string(fields[5]);
+            if (fields.size() > 6) command.text[2] = std::string(fields[6]);
+            // An unquoted address with commas spills into extra fields, like in the old data files
+            for (std::size_t i = 7; i < fields.size(); i++) {
+                if (i > 7) command.text[3] += ',';
+                command.text[3] += fields[i];
+            }
+            break;
+        case BatchCommandType::AddCourse:
+            command.text[0] = std::string(fields[1]);
+            command.text[1] = std::string(fields[2]);
+            command.text[2] = std::string(fields[3]);
+            ok = Csv::parseInt(fields[4], command.credits) && Csv::parseInt(fields[5], command.capacity);
+            break;
+        case BatchCommandType::Enroll:
+        case BatchCommandType::Drop:
+            ok = Csv::parseInt(fields[1], command.rollNo);
+            command.text[0] = std::string(fields[2]);
+            break;
+        case BatchCommandType::UpdateGrade:
+            ok = Csv::parseInt(fields[1], command.rollNo) && Csv::parseFloat(fields[2], command.grade);
+            break;
+        case BatchCommandType::DeleteStudent:
+            ok = Csv::parseInt(fields[1], command.rollNo);
+            break;
+    }
+    if (!ok) {
+        error = "malformed number in " + std::string(spec->name);
+    }
+    return ok;
+}
+
+static bool apply(StudentManagement& sm, const BatchCommand& command, std::string& error) {
+    switch (command.type) {
+        case BatchCommandType::AddStudent:
+            return sm.insertStudent(command.text[0], command.rollNo, command.grade, command.attendance,
+                                    command.text[1], command.text[2], command.text[3], error);
+        case BatchCommandType::AddCourse:
+            return sm.insertCourse(command.text[0], command.text[1], command.text[2],
+                                   command.credits, command.capacity, error);
+        case BatchCommandType::Enroll:
+            return sm.enroll(command.rollNo, command.text[0], error);
+        case BatchCommandType::Drop:
+            return sm.drop(command.rollNo, command.text[0], error);
+        case BatchCommandType::UpdateGrade:
+            return sm.setGrade(command.rollNo, command.grade, error);
+        case BatchCommandType::DeleteStudent:
+            if (sm.deleteStudents({command.rollNo}) == 0) {
+                error = "Student with roll number " + std::to_string(command.rollNo) + " not found!";
+                return false;
+            }
+            return true;
+    }
+    return false;
+}
+
+// Hands the parsed add-student and add-course rows to the validation stage and attaches
+// what it found to the commands. A roll number deleted by an earlier row may be added again
+static void validateAdds(const StudentManagement& sm, std::vector<BatchCommand>& commands) {
+    std::vector<StudentRow> students;
+    std::vector<CourseRow> courses;
+    std::unordered_map<int, std::size_t> deletes;
+    for (const auto& command : commands) {
+        if (!command.parseError.empty()) {
+            continue;
+        }
+        if (command.type == BatchCommandType::AddStudent) {
+            auto deleted = deletes.find(command.rollNo);
+            students.push_back({command.line, command.text[0], command.rollNo, command.grade, command.attendance,
+                                command.text[1], command.text[2], deleted == deletes.end() ? 0 : deleted->second});
+        } else if (command.type == BatchCommandType::AddCourse) {
+            courses.push_back({command.line, command.text[0], command.text[1], command.text[2],
+                               command.credits, command.capacity});
+        } else if (command.type == BatchCommandType::DeleteStudent) {
+            deletes[command.rollNo]++;
+        }
+    }
+    if (students.empty() && courses.empty()) {
+        return;
+    }
+
+    ThreadPool pool;
+    std::vector<ValidationIssue> issues = ImportValidator::validate(sm, students, courses, pool);
+
+    // Commands and issues are both in line order
+    auto command = commands.begin();
+    for (auto& issue : issues) {
+        command = std::lower_bound(command, commands.end(), issue.row, [](const BatchCommand& c, std::size_t line) {
+            return c.line < line;
+        });
+        command->issues.push_back(std::move(issue));
+    }
+}
+
+bool BatchRunner::runFile(StudentManagement& sm, const std::string& path, BatchReport& report) {
+    if (path == "-") {
+        std::string input((std::istreambuf_iterator<char>(std::cin)), std::istreambuf_iterator<char>());
+        run(sm, input.data(), input.data() + input.size(), report);
+        return true;
+    }
+
+    MappedFile file(path);
+    if (!file.isOpen()) {
+        return false;
+    }
+    run(sm, file.begin(), file.end(), report);
+    return true;
+}
+
+void BatchRunner::run(StudentManagement& sm, char* begin, char* end, BatchReport& report) {
+    // Pass 1: every row is parsed and checked up front, before the store is touched
+    std::vector<BatchCommand> commands;
+    CsvReader reader(begin, end);
+    commands.reserve(reader.countRows());
+    std::vector<std::string_view> fields;
+    std::size_t line = 0;
+    while (reader.nextRow(fields)) {
+        line++;
+        if (fields.empty() || (fields.size() == 1 && fields[0].empty()) ||
+            (!fields[0].empty() && fields[0][0] == '#')) {
+            continue;
+        }
+
+        report.commands++;
+        BatchCommand command;
+        command.line = line;
+        parseCommand(fields, command, command.parseError);
+        commands.push_back(std::move(command));
+    }
+
+    // Pass 2: every added student and course is validated up front on the pool
+    auto start = std::chrono::steady_clock::now();
+    validateAdds(sm, commands);
+    auto validated = std::chrono::steady_clock::now();
+
+    // Pass 3: apply in order without journaling, then persist everything once
+    sm.beginBulkUpdate();
+    for (const auto& command : commands) {
+        if (!command.issues.empty()) {
+            for (const auto& issue : command.issues) {
+                report.errors.push_back({command.line, issue.field, issue.reason});
+            }
+            continue;
+        }
+        std::string error = command.parseError;
+        if (error.empty() && apply(sm, command, error)) {
+            report.applied++;
+        } else {
+            report.errors.push_back({command.line, "", error});
+        }
+    }
+    auto applied = std::chrono::steady_clock::now();
+    report.persisted = sm.endBulkUpdate();
+    auto persisted = std::chrono::steady_clock::now();
+
+    report.validateSeconds = std::chrono::duration<double>(validated - start).count();
+    report.applySeconds = std::chrono::duration<double>(applied - validated).count();
+    report.persistSeconds = std::chrono::duration<double>(persisted - applied).count();
+}
+
+void BatchRunner::printReport(const BatchReport& report) {
+    // Only the first errors are printed, a bad export can produce thousands
+    const std::size_t shownErrors = 20;
+    for (std::size_t i = 0; i < report.errors.size() && i < shownErrors; i++) {
+        const BatchError& error = report.errors[i];
+        std::string where = "line " + std::to_string(error.line);
+        if (!error.field.empty()) {
+            where += ", " + error.field;
+        }
+        UI::printError(where + ": " + error.reason);
+    }
+    if (report.errors.size() > shownErrors) {
+        UI::printWarning("... and " + std::to_string(report.errors.size() - shownErrors) + " more errors");
+    }
+
+    if (!report.persisted) {
+        UI::printError("Writing the data files failed, none of the applied commands were saved");
+    }
+
+    double opsPerSecond = report.applySeconds > 0 ? report.applied / report.applySeconds : 0;
+    std::cout << "Applied " << report.applied << " of " << report.commands << " commands in "
+              << report.applySeconds << " s (" << static_cast<long long>(opsPerSecond) << " ops/sec), "
+              << "validated in " << report.validateSeconds << " s, "
+              << "data files written in " << report.persistSeconds << " s" << std::endl;
+}
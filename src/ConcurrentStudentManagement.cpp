@@ -0,0 +1,351 @@
+#include "../include/ConcurrentStudentManagement.h"
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
+ConcurrentStudentManagement::ConcurrentStudentManagement(StudentManagement& store) : store(store) {
+    // A flush reads every table, so it must not start inside an enrollment that only holds
+    // the store lock shared; I run it myself after the change, with the lock held exclusively
+    store.setInlineFlushes(false);
+    
+    for (const auto& course : store.getCourses()) {
+        seats.track(std::string(course.getCode()), course.getMaxCapacity(), course.getCurrentEnrollment());
+    }
+}
+
+ConcurrentStudentManagement::~ConcurrentStudentManagement() {
+    store.setInlineFlushes(true);
+}
+
+std::shared_mutex& ConcurrentStudentManagement::studentShard(int rollNo) const {
+    return studentShards[static_cast<unsigned>(rollNo) % shardCount];
+}
+
+std::shared_mutex& ConcurrentStudentManagement::courseShard(const std::string& code) const {
+    return courseShards[std::hash<std::string>{}(code) % shardCount];
+}
+
+Student ConcurrentStudentManagement::copyStudent(const Student& student) const {
+    std::shared_lock<std::shared_mutex> shard(studentShard(student.getRollNo()));
+    return student;
+}
+
+std::vector<Student> ConcurrentStudentManagement::copyStudents(const std::vector<const Student*>& found) const {
+    std::vector<Student> copies;
+    copies.reserve(found.size());
+    for (const Student* student : found) {
+        copies.push_back(copyStudent(*student));
+    }
+    return copies;
+}
+
+void ConcurrentStudentManagement::flushIfDue() {
+    // The check holds the store lock shared so it never reads the counters while a flush resets them
+    {
+        std::shared_lock<std::shared_mutex> lock(storeMutex);
+        if (!store.isFlushDue()) {
+            return;
+        }
+    }
+    std::unique_lock<std::shared_mutex> lock(storeMutex);
+    store.flushIfDue();
+}
+
+std::optional<Student> ConcurrentStudentManagement::findStudent(int rollNo) const {
+    std::shared_lock<std::shared_mutex> lock(storeMutex);
+    const Student* student = store.searchStudentByRoll(rollNo);
+    if (!student) {
+        return std::nullopt;
+    }
+    return copyStudent(*student);
+}
+
+std::optional<Course> ConcurrentStudentManagement::findCourse(const std::string& code) const {
+    std::shared_lock<std::shared_mutex> lock(storeMutex);
+    const Course* course = store.searchCourseByCode(code);
+    if (!course) {
+        return std::nullopt;
+    }
+    std::shared_lock<std::shared_mutex> shard(courseShard(code));
+    return *course;
+}
+
+std::vector<std::string> ConcurrentStudentManagement::getEnrolledCourseCodes(int rollNo) const {
+    std::shared_lock<std::shared_mutex> lock(storeMutex);
+    std::vector<std::string> codes;
+    const Student* student = store.searchStudentByRoll(rollNo);
+    if (!student) {
+        return codes;
+    }
+
+    // Course codes only change with the store locked exclusively, so no course shard is needed
+    std::shared_lock<std::shared_mutex> shard(studentShard(rollNo));
+    for (CourseHandle handle : student->getEnrolledCourses()) {
+        if (const Course* course = store.getCourses().get(handle)) {
+            codes.emplace_back(course->getCode());
+        }
+    }
+    return codes;
+}
+
+std::vector<Student> ConcurrentStudentManagement::getRoster(const std::string& code) const {
+    std::shared_lock<std::shared_mutex> lock(storeMutex);
+    const Course* course = store.searchCourseByCode(code);
+    if (!course) {
+        return {};
+    }
+    
+    // Student shards come before course shards in the lock order, so the handles are
+    // collected first and the course shard is let go before the students are copied
+    std::vector<const Student*> enrolled;
+    {
+        std::shared_lock<std::shared_mutex> shard(courseShard(code));
+        enrolled.reserve(course->getEnrolledStudents().size());
+        for (StudentHandle handle : course->getEnrolledStudents()) {
+            if (const Student* student = store.getStudents().get(handle)) {
+                enrolled.push_back(student);
+            }
+        }
+    }
+    return copyStudents(enrolled);
+}
+
+std::vector<Student> ConcurrentStudentManagement::findTopPerformers(int count) const {
+    std::shared_lock<std::shared_mutex> lock(storeMutex);
+    return copyStudents(store.findTopPerformers(count));
+}
+
+std::vector<Student> ConcurrentStudentManagement::findStudentsByGradeRange(float minGrade, float maxGrade) const {
+    std::shared_lock<std::shared_mutex> lock(storeMutex);
+    return copyStudents(store.findStudentsByGradeRange(minGrade, maxGrade));
+}
+
+std::vector<Student> ConcurrentStudentManagement::findStudentsByAttendance(float minAttendance) const {
+    std::shared_lock<std::shared_mutex> lock(storeMutex);
+    return copyStudents(store.findStudentsByAttendance(minAttendance));
+}
+
+Kernels::RosterHistogram ConcurrentStudentManagement::getRosterHistogram() const {
+    std::shared_lock<std::shared_mutex> lock(storeMutex);
+    return store.getRosterHistogram();
+}
+
+bool ConcurrentStudentManagement::enroll(int rollNo, const std::string& code, std::string& error) {
+    Reservation reservation = reserveSeat(rollNo, code);
+    if (reservation.status == ReservationStatus::UnknownCourse) {
+        error = "Course with code " + code + " not found!";
+        return false;
+    }
+    if (reservation.status == ReservationStatus::Full) {
+        error = "Course is full. Cannot enroll more students!";
+        return false;
+    }
+    return confirmReservation(reservation, error);
+}
+
+bool ConcurrentStudentManagement::drop(int rollNo, const std::string& code, std::string& error) {
+    bool dropped;
+    {
+        std::shared_lock<std::shared_mutex> lock(storeMutex);
+        std::unique_lock<std::shared_mutex> student(studentShard(rollNo));
+        std::unique_lock<std::shared_mutex> course(courseShard(code));
+        dropped = store.drop(rollNo, code, error);
+    }
+    if (dropped) {
+        releaseSeat(code);
+        promoteWaitlisted(code);
+    }
+    flushIfDue();
+    return dropped;
+}
+
+Reservation ConcurrentStudentManagement::reserveSeat(int rollNo, const std::string& code, bool joinWaitlist) {
+    Reservation reservation;
+    reservation.rollNo = rollNo;
+    reservation.code = code;
+    {
+        std::shared_lock<std::shared_mutex> lock(storeMutex);
+        SeatReservations::CourseSeats* course = seats.find(code);
+        if (!course) {
+            reservation.status = ReservationStatus::UnknownCourse;
+            return reservation;
+        }
+        if (SeatReservations::tryTake(*course)) {
+            reservation.status = ReservationStatus::Held;
+            return reservation;
+        }
+        if (!joinWaitlist) {
+            reservation.status = ReservationStatus::Full;
+            return reservation;
+        }
+        SeatReservations::joinWaitlist(*course, rollNo);
+        reservation.status = ReservationStatus::Waitlisted;
+    }
+    // A seat may have been freed between the full check and joining the list
+    promoteWaitlisted(code);
+    return reservation;
+}
+
+bool ConcurrentStudentManagement::confirmReservation(Reservation& reservation, std::string& error) {
+    if (reservation.status != ReservationStatus::Held) {
+        error = "Reservation for " + reservation.code + " is not holding a seat";
+        return false;
+    }
+    reservation.status = ReservationStatus::Cancelled;
+    if (!confirmSeat(reservation.rollNo, reservation.code, error)) {
+        promoteWaitlisted(reservation.code);
+        return false;
+    }
+    reservation.status = ReservationStatus::Confirmed;
+    return true;
+}
+
+void ConcurrentStudentManagement::cancelReservation(Reservation& reservation) {
+    if (reservation.status == ReservationStatus::Held) {
+        releaseSeat(reservation.code);
+        promoteWaitlisted(reservation.code);
+    } else if (reservation.status == ReservationStatus::Waitlisted) {
+        std::shared_lock<std::shared_mutex> lock(storeMutex);
+        if (SeatReservations::CourseSeats* course = seats.find(reservation.code)) {
+            SeatReservations::leaveWaitlist(*course, reservation.rollNo);
+        }
+    }
+    reservation.status = ReservationStatus::Cancelled;
+}
+
+bool ConcurrentStudentManagement::confirmSeat(int rollNo, const std::string& code, std::string& error) {
+    bool enrolled;
+    {
+        std::shared_lock<std::shared_mutex> lock(storeMutex);
+        std::unique_lock<std::shared_mutex> student(studentShard(rollNo));
+        std::unique_lock<std::shared_mutex> course(courseShard(code));
+        enrolled = store.enroll(rollNo, code, error);
+    }
+    if (!enrolled) {
+        releaseSeat(code);
+    }
+    flushIfDue();
+    return enrolled;
+}
+
+void ConcurrentStudentManagement::releaseSeat(const std::string& code) {
+    // The course may have been deleted since the seat was taken, then there is nothing to give back
+    std::shared_lock<std::shared_mutex> lock(storeMutex);
+    if (SeatReservations::CourseSeats* course = seats.find(code)) {
+        SeatReservations::release(*course);
+    }
+}
+
+void ConcurrentStudentManagement::promoteWaitlisted(const std::string& code) {
+    while (true) {
+        int rollNo;
+        {
+            std::shared_lock<std::shared_mutex> lock(storeMutex);
+            SeatReservations::CourseSeats* course = seats.find(code);
+            if (!course || !SeatReservations::promote(*course, rollNo)) {
+                return;
+            }
+        }
+        // A student who was deleted or enrolled meanwhile gives the seat back to the next one
+        std::string error;
+        confirmSeat(rollNo, code, error);
+    }
+}
+
+bool ConcurrentStudentManagement::insertStudent(const std::string& name, int rollNo, float grade, float attendance,
+                                                const std::string& email, const std::string& phone,
+                                                const std::string& address, std::string& error) {
+    bool inserted;
+    {
+        std::unique_lock<std::shared_mutex> lock(storeMutex);
+        inserted = store.insertStudent(name, rollNo, grade, attendance, email, phone, address, error);
+    }
+    flushIfDue();
+    return inserted;
+}
+
+bool ConcurrentStudentManagement::insertCourse(const std::string& code, const std::string& name,
+                                               const std::string& instructor, int credits, int maxCapacity,
+                                               std::string& error) {
+    bool inserted;
+    {
+        std::unique_lock<std::shared_mutex> lock(storeMutex);
+        inserted = store.insertCourse(code, name, instructor, credits, maxCapacity, error);
+        if (inserted) {
+            seats.track(code, maxCapacity, 0);
+        }
+    }
+    flushIfDue();
+    return inserted;
+}
+
+bool ConcurrentStudentManagement::setGrade(int rollNo, float grade, std::string& error) {
+    bool updated;
+    {
+        std::unique_lock<std::shared_mutex> lock(storeMutex);
+        updated = store.setGrade(rollNo, grade, error);
+    }
+    flushIfDue();
+    return updated;
+}
+
+std::size_t ConcurrentStudentManagement::deleteStudents(const std::vector<int>& rollNos) {
+    std::size_t deleted;
+    std::vector<std::string> freedCodes;
+    {
+        std::unique_lock<std::shared_mutex> lock(storeMutex);
+        
+        // Seats held by the deleted students go back to their courses
+        std::unordered_map<std::string, int> enrolledBefore;
+        for (int rollNo : rollNos) {
+            const Student* student = store.searchStudentByRoll(rollNo);
+            if (!student) {
+                continue;
+            }
+            for (CourseHandle handle : student->getEnrolledCourses()) {
+                if (const Course* course = store.getCourses().get(handle)) {
+                    enrolledBefore.emplace(std::string(course->getCode()), course->getCurrentEnrollment());
+                }
+            }
+        }
+        
+        deleted = store.deleteStudents(rollNos);
+        
+        for (const auto& [code, before] : enrolledBefore) {
+            SeatReservations::CourseSeats* seatsLeft = seats.find(code);
+            const Course* course = store.searchCourseByCode(code);
+            if (!seatsLeft || !course) {
+                continue;
+            }
+            for (int i = course->getCurrentEnrollment(); i < before; i++) {
+                SeatReservations::release(*seatsLeft);
+            }
+            freedCodes.push_back(code);
+        }
+    }
+    for (const auto& code : freedCodes) {
+        promoteWaitlisted(code);
+    }
+    flushIfDue();
+    return deleted;
+}
+
+std::size_t ConcurrentStudentManagement::deleteCourses(const std::vector<std::string>& codes) {
+    std::size_t deleted;
+    {
+        std::unique_lock<std::shared_mutex> lock(storeMutex);
+        deleted = store.deleteCourses(codes);
+        for (const auto& code : codes) {
+            if (!store.searchCourseByCode(code)) {
+                seats.untrack(code);
+            }
+        }
+    }
+    flushIfDue();
+    return deleted;
+}
+
+void ConcurrentStudentManagement::flushDataFiles() {
+    std::unique_lock<std::shared_mutex> lock(storeMutex);
+    store.flushDataFiles();
+}
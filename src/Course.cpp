@@ -1,111 +1,112 @@
 #include "../include/Course.h"
 #include "../include/Student.h"
+#include "../include/CsvWriter.h"
+#include "../include/ReportWriter.h"
 
 // I designed these Course constructors to be flexible for different initialization scenarios
 // The first constructor is for when I don't have an ID yet (new courses)
-Course::Course(std::string code, std::string name, std::string instructor, 
+Course::Course(std::string_view code, std::string_view name, std::string_view instructor, 
                int credits, int maxCapacity)
-    : id(0), code(code), name(name), instructor(instructor), 
+    : id(0), code(code), name(StringPool::courseNames().intern(name)),
+      instructor(StringPool::instructors().intern(instructor)), 
       credits(credits), maxCapacity(maxCapacity) {}
 
-Course::Course(int id, std::string code, std::string name, std::string instructor, 
-               int credits, int maxCapacity)
-    : id(id), code(code), name(name), instructor(instructor), 
-      credits(credits), maxCapacity(maxCapacity) {}
+Course::Course(int id, std::string_view code, std::string_view name, std::string_view instructor, 
+               int credits, int maxCapacity, RecordResources resources)
+    : id(id), code(code, resources.strings), name(StringPool::courseNames().intern(name)),
+      instructor(StringPool::instructors().intern(instructor)), credits(credits), maxCapacity(maxCapacity),
+      enrolledStudents(resources.lists) {}
 
 // Getter implementations
 int Course::getId() const { return id; }
-std::string Course::getCode() const { return code; }
-std::string Course::getName() const { return name; }
-std::string Course::getInstructor() const { return instructor; }
+std::string_view Course::getCode() const { return code; }
+std::string_view Course::getName() const { return StringPool::courseNames().text(name); }
+std::string_view Course::getInstructor() const { return StringPool::instructors().text(instructor); }
+StringId Course::getNameId() const { return name; }
+StringId Course::getInstructorId() const { return instructor; }
 int Course::getCredits() const { return credits; }
 int Course::getMaxCapacity() const { return maxCapacity; }
 int Course::getCurrentEnrollment() const { return enrolledStudents.size(); }
-std::vector<Student*> Course::getEnrolledStudents() const { return enrolledStudents; }
+const HandleSet<Student>& Course::getEnrolledStudents() const { return enrolledStudents; }
 
 // Setter implementations
 void Course::setId(int id) { this->id = id; }
 void Course::setCode(std::string code) { this->code = code; }
-void Course::setName(std::string name) { this->name = name; }
-void Course::setInstructor(std::string instructor) { this->instructor = instructor; }
+void Course::setName(std::string name) { this->name = StringPool::courseNames().intern(name); }
+void Course::setInstructor(std::string instructor) { this->instructor = StringPool::instructors().intern(instructor); }
 void Course::setCredits(int credits) { this->credits = credits; }
 void Course::setMaxCapacity(int maxCapacity) { this->maxCapacity = maxCapacity; }
 
 // Student management methods
-bool Course::addStudent(Student* student) {
-    if (isFull() || hasStudent(student)) {
+bool Course::addStudent(StudentHandle student) {
+    if (isFull()) {
         return false;
     }
-    enrolledStudents.push_back(student);
-    return true;
+    return enrolledStudents.insert(student);
 }
 
-bool Course::removeStudent(Student* student) {
-    for (auto it = enrolledStudents.begin(); it != enrolledStudents.end(); ++it) {
-        if (*it == student) {
-            enrolledStudents.erase(it);
-            return true;
-        }
-    }
-    return false;
+bool Course::removeStudent(StudentHandle student) {
+    return enrolledStudents.erase(student);
 }
 
 bool Course::isFull() const {
     return static_cast<int>(enrolledStudents.size()) >= maxCapacity;
 }
 
-bool Course::hasStudent(Student* student) const {
-    for (const auto& s : enrolledStudents) {
-        if (s == student) {
-            return true;
-        }
-    }
-    return false;
+bool Course::hasStudent(StudentHandle student) const {
+    return enrolledStudents.contains(student);
+}
+
+void Course::reserveSeats(std::size_t count) {
+    enrolledStudents.reserve(count);
 }
 
 // Display methods
-void Course::display() const {
-    std::cout << "| " << std::left << std::setw(10) << code << " | "
-              << std::setw(25) << name << " | "
-              << std::setw(20) << instructor << " | "
-              << std::setw(7) << credits << " | "
-              << std::right << std::setw(3) << enrolledStudents.size() << "/"
-              << std::left << std::setw(3) << maxCapacity << " |" << std::endl;
+void Course::display(ReportWriter& out) const {
+    out.text("| ").cell(code, 10).text(" | ")
+       .cell(getName(), 25).text(" | ")
+       .cell(getInstructor(), 20).text(" | ")
+       .cell(credits, 7).text(" | ")
+       .rightCell(enrolledStudents.size(), 3).text("/")
+       .cell(maxCapacity, 3).text(" |").endLine();
 }
 
-void Course::displayDetailed() const {
-    std::cout << "+----------------------------------+\n";
-    std::cout << "| Course Details                   |\n";
-    std::cout << "+----------------------------------+\n";
-    std::cout << "| ID        : " << std::left << std::setw(23) << id << " |\n";
-    std::cout << "| Code      : " << std::left << std::setw(23) << code << " |\n";
-    std::cout << "| Name      : " << std::left << std::setw(23) << name << " |\n";
-    std::cout << "| Instructor: " << std::left << std::setw(23) << instructor << " |\n";
-    std::cout << "| Credits   : " << std::left << std::setw(23) << credits << " |\n";
-    std::cout << "| Capacity  : " << std::left << std::setw(23) << enrolledStudents.size() << "/" << maxCapacity << " |\n";
-    std::cout << "+----------------------------------+\n";
+void Course::displayDetailed(ReportWriter& out) const {
+    out.text("+----------------------------------+").endLine();
+    out.text("| Course Details                   |").endLine();
+    out.text("+----------------------------------+").endLine();
+    out.text("| ID        : ").cell(id, 23).text(" |").endLine();
+    out.text("| Code      : ").cell(code, 23).text(" |").endLine();
+    out.text("| Name      : ").cell(getName(), 23).text(" |").endLine();
+    out.text("| Instructor: ").cell(getInstructor(), 23).text(" |").endLine();
+    out.text("| Credits   : ").cell(credits, 23).text(" |").endLine();
+    out.text("| Capacity  : ").cell(enrolledStudents.size(), 23).text("/").cell(maxCapacity, 0).text(" |").endLine();
+    out.text("+----------------------------------+").endLine();
 }
 
-void Course::displayEnrollmentList() const {
-    std::cout << "+----------------------------------+\n";
-    std::cout << "| " << code << " - " << name << " Enrollment List |\n";
-    std::cout << "+----------------------------------+\n";
-    std::cout << "| Roll No   | Student Name         |\n";
-    std::cout << "+----------------------------------+\n";
-    for (const auto& student : enrolledStudents) {
-        std::cout << "| " << std::setw(9) << student->getRollNo() << " | " 
-                  << std::setw(20) << student->getName() << " |\n";
+void Course::displayEnrollmentList(const SlotMap<Student>& students, ReportWriter& out) const {
+    out.text("+----------------------------------+").endLine();
+    out.text("| ").text(getCode()).text(" - ").text(getName()).text(" Enrollment List |").endLine();
+    out.text("+----------------------------------+").endLine();
+    out.text("| Roll No   | Student Name         |").endLine();
+    out.text("+----------------------------------+").endLine();
+    for (const auto& handle : enrolledStudents) {
+        const Student* student = students.get(handle);
+        if (student) {
+            out.text("| ").cell(student->getRollNo(), 9).text(" | ").cell(student->getName(), 20).text(" |").endLine();
+        }
     }
-    std::cout << "+----------------------------------+\n";
-    std::cout << "| Total Enrolled: " << std::setw(17) << enrolledStudents.size() << " |\n";
-    std::cout << "+----------------------------------+\n";
+    out.text("+----------------------------------+").endLine();
+    out.text("| Total Enrolled: ").cell(enrolledStudents.size(), 17).text(" |").endLine();
+    out.text("+----------------------------------+").endLine();
 }
 
-std::string Course::toCSV() const {
-    return std::to_string(id) + "," +
-           code + "," +
-           name + "," +
-           instructor + "," +
-           std::to_string(credits) + "," +
-           std::to_string(maxCapacity);
+void Course::writeCSV(CsvWriter& writer) const {
+    writer.field(id);
+    writer.field(code);
+    writer.field(getName());
+    writer.field(getInstructor());
+    writer.field(credits);
+    writer.field(maxCapacity);
+    writer.endRow();
 }
@@ -0,0 +1,180 @@
+#include "../include/CsvReader.h"
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <sstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// On Linux/Mac I map the file copy-on-write; elsewhere I fall back to reading it into a string
+MappedFile::MappedFile(const std::string& path) : data(nullptr), length(0), mapped(false), opened(false) {
+#ifndef _WIN32
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return;
+    }
+    opened = true;
+
+    struct stat info;
+    bool haveSize = ::fstat(fd, &info) == 0;
+    if (haveSize && info.st_size > 0) {
+        void* region = ::mmap(nullptr, info.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        if (region != MAP_FAILED) {
+            data = static_cast<char*>(region);
+            length = info.st_size;
+            mapped = true;
+        }
+    }
+    ::close(fd);
+    if (mapped || (haveSize && info.st_size == 0)) {
+        return;
+    }
+#endif
+
+    std::ifstream inFile(path, std::ios::binary);
+    if (!inFile) {
+        return;
+    }
+    opened = true;
+    std::stringstream buffer;
+    buffer << inFile.rdbuf();
+    fallback = buffer.str();
+    data = &fallback[0];
+    length = fallback.size();
+}
+
+MappedFile::~MappedFile() {
+#ifndef _WIN32
+    if (mapped) {
+        ::munmap(data, length);
+    }
+#endif
+}
+
+bool MappedFile::isOpen() const { return opened; }
+
+CsvReader::CsvReader(char* begin, char* end) : cursor(begin), limit(end) {}
+
+std::size_t CsvReader::countRows() const {
+    if (cursor >= limit) {
+        return 0;
+    }
+    std::size_t rows = std::count(cursor, limit, '\n');
+    return limit[-1] == '\n' ? rows : rows + 1;
+}
+
+bool CsvReader::nextRow(std::vector<std::string_view>& fields) {
+    fields.clear();
+    char* end = limit;
+    if (cursor >= end) {
+        return false;
+    }
+
+    while (true) {
+        if (*cursor == '"') {
+            // Quoted field: "" becomes " and commas or newlines inside are kept
+            char* start = cursor + 1;
+            char* read = start;
+            char* write = start;
+            while (read < end) {
+                if (*read == '"') {
+                    if (read + 1 < end && read[1] == '"') {
+                        *write++ = '"';
+                        read += 2;
+                        continue;
+                    }
+                    ++read;
+                    break;
+                }
+                *write++ = *read++;
+            }
+            fields.emplace_back(start, write - start);
+
+            // Anything between the closing quote and the delimiter is ignored
+            while (read < end && *read != ',' && *read != '\n') {
+                ++read;
+            }
+            cursor = read;
+        } else {
+            char* start = cursor;
+            while (cursor < end && *cursor != ',' && *cursor != '\n') {
+                ++cursor;
+            }
+            std::size_t length = cursor - start;
+            if (length > 0 && start[length - 1] == '\r' && (cursor == end || *cursor == '\n')) {
+                length--;
+            }
+            fields.emplace_back(start, length);
+        }
+
+        if (cursor < end && *cursor == ',') {
+            ++cursor;
+            if (cursor == end) {
+                fields.emplace_back();
+            }
+            if (cursor < end) {
+                continue;
+            }
+        }
+        if (cursor < end) {
+            ++cursor; // Skip the newline
+        }
+        return true;
+    }
+}
+
+std::vector<char*> Csv::splitRows(char* begin, char* end, std::size_t parts) {
+    std::vector<char*> bounds{begin};
+    if (parts <= 1 || begin >= end) {
+        bounds.push_back(end);
+        return bounds;
+    }
+
+    // Every "" escape adds two quotes, so the parity of the quotes seen so far
+    // tells whether a position is inside a quoted field
+    std::size_t length = end - begin;
+    bool inQuotes = false;
+    char* scanned = begin;
+    for (std::size_t k = 1; k < parts; k++) {
+        char* target = begin + length * k / parts;
+        if (target <= bounds.back()) {
+            continue;
+        }
+        for (; scanned < target; ++scanned) {
+            if (*scanned == '"') {
+                inQuotes = !inQuotes;
+            }
+        }
+        while (scanned < end && (inQuotes || *scanned != '\n')) {
+            if (*scanned == '"') {
+                inQuotes = !inQuotes;
+            }
+            ++scanned;
+        }
+        if (scanned >= end) {
+            break;
+        }
+        ++scanned; // The row starts after the newline
+        bounds.push_back(scanned);
+    }
+    if (bounds.back() != end) {
+        bounds.push_back(end);
+    }
+    return bounds;
+}
+
+// The whole field has to be the number; "12abc" is not 12
+bool Csv::parseInt(std::string_view text, int& value) {
+    auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+    return result.ec == std::errc() && result.ptr == text.data() + text.size();
+}
+
+bool Csv::parseFloat(std::string_view text, float& value) {
+    auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+    return result.ec == std::errc() && result.ptr == text.data() + text.size();
+}
@@ -0,0 +1,86 @@
+#include "../include/CsvWriter.h"
+#include <charconv>
+#include <cstring>
+
+CsvWriter::CsvWriter(std::ostream& out, std::size_t bufferBytes) : out(out), buffer(bufferBytes) {}
+
+CsvWriter::~CsvWriter() {
+    flush();
+}
+
+// Makes room for bytes more characters, draining the buffer to the stream when it is full
+// A single value bigger than the whole buffer grows it instead
+char* CsvWriter::reserve(std::size_t bytes) {
+    if (used + bytes > buffer.size()) {
+        flush();
+        if (bytes > buffer.size()) {
+            buffer.resize(bytes);
+        }
+    }
+    return buffer.data() + used;
+}
+
+void CsvWriter::separator() {
+    if (rowStarted) {
+        *reserve(1) = ',';
+        used++;
+    }
+    rowStarted = true;
+}
+
+void CsvWriter::field(std::string_view text) {
+    separator();
+    if (text.find_first_of(",\"\n\r") == std::string_view::npos) {
+        std::memcpy(reserve(text.size()), text.data(), text.size());
+        used += text.size();
+        return;
+    }
+
+    // Worst case every character is a quote that has to be doubled, plus the outer quotes
+    char* start = reserve(text.size() * 2 + 2);
+    char* write = start;
+    *write++ = '"';
+    for (char c : text) {
+        if (c == '"') {
+            *write++ = '"';
+        }
+        *write++ = c;
+    }
+    *write++ = '"';
+    used += write - start;
+}
+
+void CsvWriter::field(int value) {
+    separator();
+    char* start = reserve(16);
+    auto result = std::to_chars(start, start + 16, value);
+    used += result.ptr - start;
+}
+
+void CsvWriter::field(float value) {
+    separator();
+    // std::to_string goes through double, so I format the widened value the same way
+    const std::size_t maxChars = 64;
+    char* start = reserve(maxChars);
+    auto result = std::to_chars(start, start + maxChars, static_cast<double>(value), std::chars_format::fixed, 6);
+    used += result.ptr - start;
+}
+
+void CsvWriter::endRow() {
+    *reserve(1) = '\n';
+    used++;
+    rowStarted = false;
+}
+
+void CsvWriter::line(std::string_view text) {
+    std::memcpy(reserve(text.size()), text.data(), text.size());
+    used += text.size();
+    endRow();
+}
+
+void CsvWriter::flush() {
+    if (used > 0) {
+        out.write(buffer.data(), static_cast<std::streamsize>(used));
+        used = 0;
+    }
+}
@@ -0,0 +1,131 @@
+#include "../include/DataLoader.h"
+#include "../include/CsvReader.h"
+#include <algorithm>
+#include <future>
+
+// Small files are not worth splitting, so every chunk gets at least this many bytes
+static const std::size_t minChunkBytes = 256 * 1024;
+
+static void parseStudentRows(char* begin, char* end, std::vector<Student>& out, RecordResources resources) {
+    CsvReader reader(begin, end);
+    out.reserve(reader.countRows());
+    std::vector<std::string_view> fields;
+
+    while (reader.nextRow(fields)) {
+        if (fields.size() < 8) {
+            continue;
+        }
+
+        int id, rollNo;
+        float grade, attendance;
+        if (!Csv::parseInt(fields[0], id) || !Csv::parseInt(fields[2], rollNo) ||
+            !Csv::parseFloat(fields[3], grade) || !Csv::parseFloat(fields[4], attendance)) {
+            continue;
+        }
+
+        // Older files wrote addresses like Patna, Bihar without quotes,
+        // so any extra fields belong to the address, which is the last column
+        // The address normally is a view into the mapped file; only a split one is glued together
+        std::string_view address = fields[7];
+        std::string joined;
+        if (fields.size() > 8) {
+            joined = std::string(fields[7]);
+            for (std::size_t i = 8; i < fields.size(); i++) {
+                joined += ',';
+                joined += fields[i];
+            }
+            address = joined;
+        }
+
+        out.emplace_back(id, fields[1], rollNo, grade, attendance, fields[5], fields[6], address, resources);
+    }
+}
+
+static void parseCourseRows(char* begin, char* end, std::vector<Course>& out, RecordResources resources) {
+    CsvReader reader(begin, end);
+    out.reserve(reader.countRows());
+    std::vector<std::string_view> fields;
+
+    while (reader.nextRow(fields)) {
+        if (fields.size() < 6) {
+            continue;
+        }
+
+        int id, credits, maxCapacity;
+        if (!Csv::parseInt(fields[0], id) || !Csv::parseInt(fields[4], credits) ||
+            !Csv::parseInt(fields[5], maxCapacity)) {
+            continue;
+        }
+
+        out.emplace_back(id, fields[1], fields[2], fields[3], credits, maxCapacity, resources);
+    }
+}
+
+static void parseEnrollmentRows(char* begin, char* end, std::vector<std::pair<int, int>>& out, RecordResources) {
+    CsvReader reader(begin, end);
+    out.reserve(reader.countRows());
+    std::vector<std::string_view> fields;
+
+    while (reader.nextRow(fields)) {
+        int studentId, courseId;
+        if (fields.size() >= 2 && Csv::parseInt(fields[0], studentId) && Csv::parseInt(fields[1], courseId)) {
+            out.emplace_back(studentId, courseId);
+        }
+    }
+}
+
+// Skips the header row and queues one parse task per byte range of the file
+template <typename Row, typename Parser>
+static void scheduleChunks(const MappedFile& file, std::vector<std::vector<Row>>& chunks, Parser parser,
+                           RecordArena& arena, ThreadPool& pool, std::vector<std::future<void>>& pending) {
+    CsvReader header(file.begin(), file.end());
+    std::vector<std::string_view> fields;
+    header.nextRow(fields);
+
+    char* body = header.position();
+    std::size_t parts = std::min(pool.size(), std::max<std::size_t>(1, (file.end() - body) / minChunkBytes));
+    std::vector<char*> bounds = Csv::splitRows(body, file.end(), parts);
+
+    // Sized before any task starts so the tasks can keep references into it
+    chunks.resize(bounds.size() - 1);
+    for (std::size_t i = 0; i + 1 < bounds.size(); i++) {
+        char* begin = bounds[i];
+        char* end = bounds[i + 1];
+        std::vector<Row>& out = chunks[i];
+        // Each task gets its own string pool; the text of the chunk bounds what its strings need
+        RecordResources resources = arena.newChunk(end - begin);
+        pending.push_back(pool.submit([begin, end, &out, parser, resources]() { parser(begin, end, out, resources); }));
+    }
+}
+
+ParsedTables DataLoader::parseAll(const std::string& studentFile, const std::string& courseFile,
+                                  const std::string& enrollmentFile, ThreadPool& pool) {
+    ParsedTables tables;
+    MappedFile students(studentFile);
+    MappedFile courses(courseFile);
+    MappedFile enrollments(enrollmentFile);
+    tables.studentsFound = students.isOpen();
+    tables.coursesFound = courses.isOpen();
+    tables.enrollmentsFound = enrollments.isOpen();
+
+    std::vector<std::future<void>> pending;
+    if (tables.studentsFound) {
+        scheduleChunks(students, tables.studentChunks, parseStudentRows, *tables.arena, pool, pending);
+    }
+    if (tables.coursesFound) {
+        scheduleChunks(courses, tables.courseChunks, parseCourseRows, *tables.arena, pool, pending);
+    }
+    if (tables.enrollmentsFound) {
+        scheduleChunks(enrollments, tables.enrollmentChunks, parseEnrollmentRows, *tables.arena, pool, pending);
+    }
+
+    // The mapped files must outlive every parse task, so wait for all of them
+    // before get() gets a chance to rethrow a failure
+    for (auto& task : pending) {
+        task.wait();
+    }
+    for (auto& task : pending) {
+        task.get();
+    }
+    return tables;
+}
@@ -0,0 +1,500 @@
+#include "../include/HttpServer.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+#ifdef __linux__
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+// Requests bigger than this are refused; the API only takes a few short parameters
+static const std::size_t maxHeaderBytes = 16 * 1024;
+static const std::size_t maxBodyBytes = 64 * 1024;
+// The most a connection buffers, pipelined requests included; it always fits one whole request
+static const std::size_t maxBufferedBytes = maxHeaderBytes + 4 + maxBodyBytes;
+
+static const std::uint64_t listenTag = 0;
+static const std::uint64_t wakeTag = 1;
+
+enum class ParseResult { Incomplete, Complete, Invalid, TooLarge };
+
+static std::string lowercase(std::string text) {
+    std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return std::tolower(c); });
+    return text;
+}
+
+// Decodes %XX escapes and '+' as used in query strings and form bodies
+static std::string urlDecode(const std::string& text) {
+    std::string decoded;
+    decoded.reserve(text.size());
+    for (std::size_t i = 0; i < text.size(); i++) {
+        if (text[i] == '+') {
+            decoded += ' ';
+        } else if (text[i] == '%' && i + 2 < text.size() &&
+                   std::isxdigit(static_cast<unsigned char>(text[i + 1])) &&
+                   std::isxdigit(static_cast<unsigned char>(text[i + 2]))) {
+            decoded += static_cast<char>(std::stoi(text.substr(i + 1, 2), nullptr, 16));
+            i += 2;
+        } else {
+            decoded += text[i];
+        }
+    }
+    return decoded;
+}
+
+static void parseParams(const std::string& text, std::map<std::string, std::string>& params) {
+    std::size_t start = 0;
+    while (start < text.size()) {
+        std::size_t end = text.find('&', start);
+        if (end == std::string::npos) {
+            end = text.size();
+        }
+        std::string pair = text.substr(start, end - start);
+        std::size_t equals = pair.find('=');
+        if (!pair.empty()) {
+            if (equals == std::string::npos) {
+                params[urlDecode(pair)] = "";
+            } else {
+                params[urlDecode(pair.substr(0, equals))] = urlDecode(pair.substr(equals + 1));
+            }
+        }
+        start = end + 1;
+    }
+}
+
+// Parses one request from the front of input; consumed is how many bytes it used
+static ParseResult parseRequest(const std::string& input, HttpRequest& request, std::size_t& consumed) {
+    std::size_t headerEnd = input.find("\r\n\r\n");
+    if (headerEnd == std::string::npos) {
+        return input.size() > maxHeaderBytes ? ParseResult::TooLarge : ParseResult::Incomplete;
+    }
+
+    std::size_t lineEnd = input.find("\r\n");
+    std::string requestLine = input.substr(0, lineEnd);
+    std::size_t firstSpace = requestLine.find(' ');
+    std::size_t secondSpace = requestLine.find(' ', firstSpace + 1);
+    if (firstSpace == std::string::npos || secondSpace == std::string::npos) {
+        return ParseResult::Invalid;
+    }
+    request.method = requestLine.substr(0, firstSpace);
+    std::string target = requestLine.substr(firstSpace + 1, secondSpace - firstSpace - 1);
+    std::string version = requestLine.substr(secondSpace + 1);
+    if (version != "HTTP/1.1" && version != "HTTP/1.0") {
+        return ParseResult::Invalid;
+    }
+
+    std::size_t question = target.find('?');
+    request.path = urlDecode(target.substr(0, question));
+    request.params.clear();
+    if (question != std::string::npos) {
+        parseParams(target.substr(question + 1), request.params);
+    }
+
+    // HTTP/1.1 keeps the connection open unless asked not to, HTTP/1.0 the other way round
+    request.keepAlive = version == "HTTP/1.1";
+    std::size_t contentLength = 0;
+    std::string contentType;
+    std::size_t position = lineEnd + 2;
+    while (position < headerEnd) {
+        std::size_t end = input.find("\r\n", position);
+        std::string line = input.substr(position, end - position);
+        position = end + 2;
+
+        std::size_t colon = line.find(':');
+        if (colon == std::string::npos) {
+            return ParseResult::Invalid;
+        }
+        std::string name = lowercase(line.substr(0, colon));
+        std::size_t valueStart = line.find_first_not_of(" \t", colon + 1);
+        std::string value = valueStart == std::string::npos ? "" : line.substr(valueStart);
+
+        if (name == "content-length") {
+            if (value.empty() || value.find_first_not_of("0123456789") != std::string::npos || value.size() > 9) {
+                return ParseResult::Invalid;
+            }
+            contentLength = std::stoul(value);
+        } else if (name == "connection") {
+            std::string option = lowercase(value);
+            if (option == "close") {
+                request.keepAlive = false;
+            } else if (option == "keep-alive") {
+                request.keepAlive = true;
+            }
+        } else if (name == "content-type") {
+            contentType = lowercase(value);
+        } else if (name == "transfer-encoding") {
+            // Chunked uploads are not needed for this API
+            return ParseResult::Invalid;
+        }
+    }
+
+    if (contentLength > maxBodyBytes) {
+        return ParseResult::TooLarge;
+    }
+    std::size_t total = headerEnd + 4 + contentLength;
+    if (input.size() < total) {
+        return ParseResult::Incomplete;
+    }
+
+    request.body = input.substr(headerEnd + 4, contentLength);
+    if (contentType.rfind("application/x-www-form-urlencoded", 0) == 0) {
+        parseParams(request.body, request.params);
+    }
+    consumed = total;
+    return ParseResult::Complete;
+}
+
+static const char* reasonPhrase(int status) {
+    switch (status) {
+        case 200: return "OK";
+        case 201: return "Created";
+        case 400: return "Bad Request";
+        case 404: return "Not Found";
+        case 405: return "Method Not Allowed";
+        case 409: return "Conflict";
+        case 413: return "Payload Too Large";
+        case 500: return "Internal Server Error";
+        case 503: return "Service Unavailable";
+    }
+    return "Unknown";
+}
+
+std::string HttpServer::serialize(const HttpResponse& response, bool keepAlive) {
+    std::string bytes;
+    bytes.reserve(response.body.size() + 128);
+    bytes += "HTTP/1.1 ";
+    bytes += std::to_string(response.status);
+    bytes += ' ';
+    bytes += reasonPhrase(response.status);
+    bytes += "\r\nContent-Type: ";
+    bytes += response.contentType;
+    bytes += "\r\nContent-Length: ";
+    bytes += std::to_string(response.body.size());
+    bytes += keepAlive ? "\r\nConnection: keep-alive\r\n\r\n" : "\r\nConnection: close\r\n\r\n";
+    bytes += response.body;
+    return bytes;
+}
+
+static HttpResponse errorResponse(int status, const std::string& message) {
+    HttpResponse response;
+    response.status = status;
+    response.body = "{\"error\":\"" + message + "\"}";
+    return response;
+}
+
+HttpServer::HttpServer(Handler handler, std::size_t workerCount)
+    : handler(std::move(handler)), workers(std::make_unique<ThreadPool>(workerCount)) {
+}
+
+#ifdef __linux__
+
+HttpServer::~HttpServer() {
+    workers.reset();
+    for (auto& entry : connections) {
+        ::close(entry.second.fd);
+    }
+    if (listenFd >= 0) ::close(listenFd);
+    if (epollFd >= 0) ::close(epollFd);
+    if (wakeFd >= 0) ::close(wakeFd);
+}
+
+bool HttpServer::start(int port, std::string& error) {
+    listenFd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listenFd < 0) {
+        error = std::string("socket: ") + std::strerror(errno);
+        return false;
+    }
+    int reuse = 1;
+    setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<std::uint16_t>(port));
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(listenFd, SOMAXCONN) != 0) {
+        error = "port " + std::to_string(port) + ": " + std::strerror(errno);
+        return false;
+    }
+    socklen_t length = sizeof(address);
+    getsockname(listenFd, reinterpret_cast<sockaddr*>(&address), &length);
+    boundPort = ntohs(address.sin_port);
+
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epollFd < 0 || wakeFd < 0) {
+        error = std::string("epoll: ") + std::strerror(errno);
+        return false;
+    }
+
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.u64 = listenTag;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event);
+    event.data.u64 = wakeTag;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event);
+    return true;
+}
+
+void HttpServer::stop() {
+    stopping = true;
+    if (wakeFd >= 0) {
+        std::uint64_t one = 1;
+        ssize_t ignored = ::write(wakeFd, &one, sizeof(one));
+        (void)ignored;
+    }
+}
+
+void HttpServer::run() {
+    std::vector<epoll_event> events(256);
+    while (!stopping) {
+        int ready = epoll_wait(epollFd, events.data(), static_cast<int>(events.size()), -1);
+        if (ready < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+
+        for (int i = 0; i < ready; i++) {
+            std::uint64_t tag = events[i].data.u64;
+            if (tag == listenTag) {
+                acceptConnections();
+            } else if (tag == wakeTag) {
+                std::uint64_t count;
+                while (::read(wakeFd, &count, sizeof(count)) > 0) {
+                }
+                drainCompletions();
+            } else {
+                // The connection may have been closed by an earlier event in this batch
+                if (connections.find(tag) == connections.end()) {
+                    continue;
+                }
+                // Reset or fully gone: nothing can be delivered any more
+                if (events[i].events & (EPOLLHUP | EPOLLERR)) {
+                    closeConnection(tag);
+                    continue;
+                }
+                if (events[i].events & EPOLLOUT) {
+                    writeTo(tag);
+                }
+                if (connections.count(tag) && (events[i].events & (EPOLLIN | EPOLLRDHUP))) {
+                    readFrom(tag);
+                }
+            }
+        }
+    }
+}
+
+void HttpServer::acceptConnections() {
+    while (true) {
+        int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            return; // EAGAIN once the backlog is empty; other errors just drop the attempt
+        }
+        int noDelay = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+        std::uint64_t id = nextConnectionId++;
+        connections[id].fd = fd;
+        connections[id].events = EPOLLIN | EPOLLRDHUP;
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.u64 = id;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+    }
+}
+
+void HttpServer::readFrom(std::uint64_t id) {
+    Connection& connection = connections[id];
+    char buffer[16 * 1024];
+    // Reading stops at the cap while earlier requests are answered; advance() picks it up again
+    while (!connection.peerClosed && connection.input.size() < maxBufferedBytes) {
+        std::size_t room = std::min(sizeof(buffer), maxBufferedBytes - connection.input.size());
+        ssize_t count = ::read(connection.fd, buffer, room);
+        if (count > 0) {
+            connection.input.append(buffer, static_cast<std::size_t>(count));
+            continue;
+        }
+        if (count == 0) {
+            // The peer is done sending, but may still be waiting for the answers
+            connection.peerClosed = true;
+            break;
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            break;
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        closeConnection(id);
+        return;
+    }
+    advance(id);
+}
+
+void HttpServer::advance(std::uint64_t id) {
+    dispatchNext(id);
+    auto it = connections.find(id);
+    if (it == connections.end()) {
+        return;
+    }
+    const Connection& connection = it->second;
+    if (connection.peerClosed && !connection.busy && connection.output.empty()) {
+        // Everything that can be answered was; a partial request will never complete
+        closeConnection(id);
+        return;
+    }
+    updateEvents(id);
+}
+
+void HttpServer::dispatchNext(std::uint64_t id) {
+    Connection& connection = connections[id];
+    if (connection.busy || connection.closeAfterWrite || connection.input.empty()) {
+        return;
+    }
+
+    HttpRequest request;
+    std::size_t consumed = 0;
+    ParseResult result = parseRequest(connection.input, request, consumed);
+    if (result == ParseResult::Incomplete) {
+        return;
+    }
+    if (result != ParseResult::Complete) {
+        // The stream can't be resynchronised after a bad request, so the connection ends here
+        int status = result == ParseResult::TooLarge ? 413 : 400;
+        connection.input.clear();
+        connection.output += serialize(errorResponse(status, reasonPhrase(status)), false);
+        connection.closeAfterWrite = true;
+        writeTo(id);
+        return;
+    }
+
+    connection.input.erase(0, consumed);
+    connection.busy = true;
+    workers->submit([this, id, request = std::move(request)]() {
+        HttpResponse response;
+        try {
+            response = handler(request);
+        } catch (const std::exception&) {
+            response = errorResponse(500, "internal error");
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(completionMutex);
+            completions.push_back({id, serialize(response, request.keepAlive), !request.keepAlive});
+        }
+        std::uint64_t one = 1;
+        ssize_t ignored = ::write(wakeFd, &one, sizeof(one));
+        (void)ignored;
+    });
+}
+
+void HttpServer::drainCompletions() {
+    std::vector<Completion> ready;
+    {
+        std::lock_guard<std::mutex> lock(completionMutex);
+        ready.swap(completions);
+    }
+    for (auto& completion : ready) {
+        auto it = connections.find(completion.connection);
+        if (it == connections.end()) {
+            continue; // The client went away before the answer was ready
+        }
+        Connection& connection = it->second;
+        connection.busy = false;
+        connection.output += completion.bytes;
+        connection.closeAfterWrite = completion.close;
+        writeTo(completion.connection);
+    }
+}
+
+void HttpServer::writeTo(std::uint64_t id) {
+    Connection& connection = connections[id];
+    while (connection.written < connection.output.size()) {
+        ssize_t count = ::send(connection.fd, connection.output.data() + connection.written,
+                               connection.output.size() - connection.written, MSG_NOSIGNAL);
+        if (count > 0) {
+            connection.written += static_cast<std::size_t>(count);
+            continue;
+        }
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            watchWrites(id, true);
+            return;
+        }
+        closeConnection(id);
+        return;
+    }
+
+    connection.output.clear();
+    connection.written = 0;
+    watchWrites(id, false);
+    if (connection.closeAfterWrite) {
+        closeConnection(id);
+        return;
+    }
+    // A pipelined request may already be waiting in the input buffer
+    advance(id);
+}
+
+void HttpServer::watchWrites(std::uint64_t id, bool enabled) {
+    connections[id].wantsWrite = enabled;
+    updateEvents(id);
+}
+
+void HttpServer::updateEvents(std::uint64_t id) {
+    Connection& connection = connections[id];
+    std::uint32_t wanted = 0;
+    if (!connection.peerClosed && connection.input.size() < maxBufferedBytes) {
+        wanted |= EPOLLIN | EPOLLRDHUP;
+    }
+    if (connection.wantsWrite) {
+        wanted |= EPOLLOUT;
+    }
+    if (wanted == connection.events) {
+        return;
+    }
+    connection.events = wanted;
+    epoll_event event{};
+    event.events = wanted;
+    event.data.u64 = id;
+    epoll_ctl(epollFd, EPOLL_CTL_MOD, connection.fd, &event);
+}
+
+void HttpServer::closeConnection(std::uint64_t id) {
+    auto it = connections.find(id);
+    if (it == connections.end()) {
+        return;
+    }
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, it->second.fd, nullptr);
+    ::close(it->second.fd);
+    connections.erase(it);
+}
+
+#else
+
+HttpServer::~HttpServer() {
+}
+
+bool HttpServer::start(int, std::string& error) {
+    error = "the server mode needs epoll and is only available on Linux";
+    return false;
+}
+
+void HttpServer::run() {
+}
+
+void HttpServer::stop() {
+    stopping = true;
+}
+
+#endif
@@ -0,0 +1,192 @@
+#include "../include/ImportValidator.h"
+#include "../include/StudentManagement.h"
+#include "../include/ThreadPool.h"
+#include "../include/Utils.h"
+#include <algorithm>
+#include <functional>
+#include <future>
+#include <unordered_map>
+
+// Runs check(begin, end) over a few ranges per worker and collects what each range found
+template <typename Check>
+static void checkInRanges(std::size_t count, ThreadPool& pool, Check check, std::vector<ValidationIssue>& issues) {
+    if (count == 0) {
+        return;
+    }
+    std::size_t ranges = std::min(count, pool.size() * 4);
+    std::vector<std::future<std::vector<ValidationIssue>>> pending;
+    for (std::size_t r = 0; r < ranges; r++) {
+        std::size_t begin = count * r / ranges;
+        std::size_t end = count * (r + 1) / ranges;
+        pending.push_back(pool.submit([&check, begin, end]() {
+            std::vector<ValidationIssue> found;
+            check(begin, end, found);
+            return found;
+        }));
+    }
+    for (auto& task : pending) {
+        std::vector<ValidationIssue> found = task.get();
+        issues.insert(issues.end(), std::make_move_iterator(found.begin()), std::make_move_iterator(found.end()));
+    }
+}
+
+static std::string keyText(int key) {
+    return std::to_string(key);
+}
+
+static std::string keyText(std::string_view key) {
+    return "'" + std::string(key) + "'";
+}
+
+// A roll number between two deletes of it; adds only clash within the same span
+struct RollNoSpan {
+    int rollNo;
+    std::size_t deletesBefore;
+
+    bool operator==(const RollNoSpan& other) const {
+        return rollNo == other.rollNo && deletesBefore == other.deletesBefore;
+    }
+};
+
+struct RollNoSpanHash {
+    std::size_t operator()(const RollNoSpan& key) const {
+        return std::hash<int>()(key.rollNo) ^ (std::hash<std::size_t>()(key.deletesBefore) * 0x9e3779b97f4a7c15ULL);
+    }
+};
+
+static std::string keyText(const RollNoSpan& key) {
+    return keyText(key.rollNo);
+}
+
+// Reports every row whose key already appeared on an earlier row
+// Each worker only looks at the keys that hash to it, so no key is seen by two workers
+// and each one keeps the first row of its own keys
+template <typename Key, typename Hash = std::hash<Key>>
+static void findRepeats(const std::vector<Key>& keys, const std::vector<std::size_t>& rows, const char* field,
+                        const char* label, ThreadPool& pool, std::vector<ValidationIssue>& issues) {
+    std::vector<std::size_t> hashes(keys.size());
+    checkInRanges(keys.size(), pool, [&](std::size_t begin, std::size_t end, std::vector<ValidationIssue>&) {
+        for (std::size_t i = begin; i < end; i++) {
+            hashes[i] = Hash()(keys[i]);
+        }
+    }, issues);
+
+    std::size_t parts = pool.size();
+    std::vector<std::future<std::vector<ValidationIssue>>> pending;
+    for (std::size_t p = 0; p < parts; p++) {
+        pending.push_back(pool.submit([&, p]() {
+            std::vector<ValidationIssue> found;
+            std::unordered_map<Key, std::size_t, Hash> firstRow;
+            for (std::size_t i = 0; i < keys.size(); i++) {
+                if (hashes[i] % parts != p) {
+                    continue;
+                }
+                auto inserted = firstRow.emplace(keys[i], rows[i]);
+                if (!inserted.second) {
+                    found.push_back({rows[i], field, std::string(label) + " " + keyText(keys[i]) +
+                                                     " already appears on line " + std::to_string(inserted.first->second)});
+                }
+            }
+            return found;
+        }));
+    }
+    for (auto& task : pending) {
+        std::vector<ValidationIssue> found = task.get();
+        issues.insert(issues.end(), std::make_move_iterator(found.begin()), std::make_move_iterator(found.end()));
+    }
+}
+
+static void checkStudents(const StudentManagement& sm, const std::vector<StudentRow>& students, std::size_t begin,
+                          std::size_t end, std::vector<ValidationIssue>& found, std::vector<char>& passed) {
+    for (std::size_t i = begin; i < end; i++) {
+        const StudentRow& s = students[i];
+        std::size_t before = found.size();
+        if (s.name.empty()) {
+            found.push_back({s.row, "name", "Student name is empty"});
+        }
+        if (s.rollNo < 1) {
+            found.push_back({s.row, "rollNo", "Roll number " + std::to_string(s.rollNo) + " is invalid"});
+        } else if (s.deletesBefore == 0 && !sm.isRollNoUnique(s.rollNo)) {
+            found.push_back({s.row, "rollNo", "Roll number " + std::to_string(s.rollNo) + " already exists"});
+        }
+        if (s.grade < 0 || s.grade > 100) {
+            found.push_back({s.row, "grade", "Grade must be between 0 and 100"});
+        }
+        if (s.attendance < 0 || s.attendance > 100) {
+            found.push_back({s.row, "attendance", "Attendance must be between 0 and 100"});
+        }
+        if (!s.email.empty() && !Validation::isValidEmail(s.email)) {
+            found.push_back({s.row, "email", "Invalid email format: " + std::string(s.email)});
+        }
+        if (!s.phone.empty() && !Validation::isValidPhone(s.phone)) {
+            found.push_back({s.row, "phone", "Invalid phone number format: " + std::string(s.phone)});
+        }
+        passed[i] = found.size() == before;
+    }
+}
+
+static void checkCourses(const StudentManagement& sm, const std::vector<CourseRow>& courses, std::size_t begin,
+                         std::size_t end, std::vector<ValidationIssue>& found, std::vector<char>& passed) {
+    for (std::size_t i = begin; i < end; i++) {
+        const CourseRow& c = courses[i];
+        std::size_t before = found.size();
+        if (c.code.empty()) {
+            found.push_back({c.row, "code", "Course code is empty"});
+        } else if (!sm.isCourseCodeUnique(std::string(c.code))) {
+            found.push_back({c.row, "code", "Course code '" + std::string(c.code) + "' already exists"});
+        }
+        if (c.name.empty()) {
+            found.push_back({c.row, "name", "Course name is required"});
+        }
+        if (c.instructor.empty()) {
+            found.push_back({c.row, "instructor", "Instructor is required"});
+        }
+        if (c.credits < 1 || c.credits > 10) {
+            found.push_back({c.row, "credits", "Credits must be 1-10"});
+        }
+        if (c.capacity < 1 || c.capacity > 200) {
+            found.push_back({c.row, "capacity", "Capacity must be 1-200"});
+        }
+        passed[i] = found.size() == before;
+    }
+}
+
+std::vector<ValidationIssue> ImportValidator::validate(const StudentManagement& sm, const std::vector<StudentRow>& students,
+                                                       const std::vector<CourseRow>& courses, ThreadPool& pool) {
+    std::vector<ValidationIssue> issues;
+    std::vector<char> studentPassed(students.size());
+    std::vector<char> coursePassed(courses.size());
+    checkInRanges(students.size(), pool, [&](std::size_t begin, std::size_t end, std::vector<ValidationIssue>& found) {
+        checkStudents(sm, students, begin, end, found, studentPassed);
+    }, issues);
+    checkInRanges(courses.size(), pool, [&](std::size_t begin, std::size_t end, std::vector<ValidationIssue>& found) {
+        checkCourses(sm, courses, begin, end, found, coursePassed);
+    }, issues);
+
+    // Only rows that passed take part, like applying in order: a rejected row doesn't
+    // claim its roll number or code, so a later row may still use it. A delete in between
+    // frees a roll number too, so adds are only compared with adds after the same deletes
+    std::vector<RollNoSpan> rollNos;
+    std::vector<std::size_t> studentRows;
+    for (std::size_t i = 0; i < students.size(); i++) {
+        if (studentPassed[i]) {
+            rollNos.push_back({students[i].rollNo, students[i].deletesBefore});
+            studentRows.push_back(students[i].row);
+        }
+    }
+    std::vector<std::string_view> codes;
+    std::vector<std::size_t> courseRows;
+    for (std::size_t i = 0; i < courses.size(); i++) {
+        if (coursePassed[i]) {
+            codes.push_back(courses[i].code);
+            courseRows.push_back(courses[i].row);
+        }
+    }
+    findRepeats<RollNoSpan, RollNoSpanHash>(rollNos, studentRows, "rollNo", "Roll number", pool, issues);
+    findRepeats(codes, courseRows, "code", "Course code", pool, issues);
+
+    std::stable_sort(issues.begin(), issues.end(), [](const ValidationIssue& a, const ValidationIssue& b) {
+        return a.row < b.row;
+    });
+    return issues;
+}
@@ -0,0 +1,199 @@
+#include "../include/Journal.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+
+// Each record is one line: the op letter followed by tab separated fields
+// Tabs, newlines and backslashes inside a field are escaped so a line is always one record
+Journal::Journal(const std::string& path) : path(path), recordCount(0) {}
+
+Journal::~Journal() {
+    if (fd >= 0) {
+        ::close(fd);
+    }
+}
+
+std::string Journal::escape(const std::string& field) {
+    std::string result;
+    result.reserve(field.size());
+    for (char c : field) {
+        switch (c) {
+            case '\\': result += "\\\\"; break;
+            case '\t': result += "\\t"; break;
+            case '\n': result += "\\n"; break;
+            default: result += c;
+        }
+    }
+    return result;
+}
+
+std::string Journal::unescape(const std::string& field) {
+    std::string result;
+    result.reserve(field.size());
+    for (std::size_t i = 0; i < field.size(); i++) {
+        if (field[i] == '\\' && i + 1 < field.size()) {
+            char next = field[++i];
+            result += next == 't' ? '\t' : next == 'n' ? '\n' : next;
+        } else {
+            result += field[i];
+        }
+    }
+    return result;
+}
+
+bool Journal::writeAll(int to, const char* data, std::size_t length) {
+    while (length > 0) {
+        ssize_t written = ::write(to, data, length);
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+        if (written <= 0) {
+            return false;
+        }
+        data += written;
+        length -= written;
+    }
+    return true;
+}
+
+bool Journal::append(JournalOp op, const std::vector<std::string>& fields) {
+    std::string line(1, static_cast<char>(op));
+    for (const auto& field : fields) {
+        line += '\t';
+        line += escape(field);
+    }
+    line += '\n';
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (fd < 0) {
+        fd = ::open(path.c_str(), O_WRONLY | O_APPEND | O_CREAT, 0644);
+        if (fd < 0) {
+            return false;
+        }
+    }
+    if (!writeAll(fd, line.data(), line.size())) {
+        return false;
+    }
+    fileBytes += line.size();
+    if (syncEveryAppend && ::fsync(fd) != 0) {
+        return false;
+    }
+    recordCount++;
+    return true;
+}
+
+std::vector<JournalRecord> Journal::readAll() {
+    std::vector<JournalRecord> records;
+    std::ifstream inFile(path, std::ios::binary);
+    if (!inFile) {
+        return records;
+    }
+
+    std::stringstream buffer;
+    buffer << inFile.rdbuf();
+    const std::string content = buffer.str();
+
+    std::size_t start = 0;
+    std::size_t end;
+    while ((end = content.find('\n', start)) != std::string::npos) {
+        std::string line = content.substr(start, end - start);
+        start = end + 1;
+        if (line.empty()) {
+            continue;
+        }
+
+        JournalRecord record;
+        record.op = static_cast<JournalOp>(line[0]);
+
+        std::size_t fieldStart = 1;
+        while (fieldStart < line.size() && line[fieldStart] == '\t') {
+            std::size_t fieldEnd = line.find('\t', fieldStart + 1);
+            if (fieldEnd == std::string::npos) {
+                fieldEnd = line.size();
+            }
+            record.fields.push_back(unescape(line.substr(fieldStart + 1, fieldEnd - fieldStart - 1)));
+            fieldStart = fieldEnd;
+        }
+        records.push_back(record);
+    }
+
+    // A crash in the middle of an append leaves a line without its newline; left in place,
+    // the next record would be glued onto it
+    if (start < content.size()) {
+        std::error_code ignored;
+        std::filesystem::resize_file(path, start, ignored);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    recordCount = records.size();
+    fileBytes = start;
+    return records;
+}
+
+std::uint64_t Journal::position() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return discarded + fileBytes;
+}
+
+bool Journal::discardBefore(std::uint64_t position) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (position <= discarded) {
+        return true;
+    }
+    std::uint64_t cut = std::min<std::uint64_t>(position - discarded, fileBytes);
+
+    // Usually nothing came in since the flush and the file is simply emptied
+    if (cut == fileBytes) {
+        int emptied = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (emptied < 0) {
+            return false;
+        }
+        ::close(emptied);
+        discarded += cut;
+        fileBytes = 0;
+        recordCount = 0;
+        return true;
+    }
+
+    // Otherwise the newer records go to a temp file that replaces the journal, so a crash
+    // leaves either the whole old journal or the new one; replaying a record twice is harmless
+    std::string tail(fileBytes - cut, '\0');
+    int in = ::open(path.c_str(), O_RDONLY);
+    if (in < 0) {
+        return false;
+    }
+    ssize_t got = ::pread(in, tail.data(), tail.size(), static_cast<off_t>(cut));
+    ::close(in);
+    if (got != static_cast<ssize_t>(tail.size())) {
+        return false;
+    }
+    std::string tempPath = path + ".tmp";
+    int out = ::open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (out < 0) {
+        return false;
+    }
+    bool written = writeAll(out, tail.data(), tail.size()) && ::fsync(out) == 0;
+    ::close(out);
+    if (!written || std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+    discarded += cut;
+    fileBytes = tail.size();
+    recordCount = std::count(tail.begin(), tail.end(), '\n');
+    return true;
+}
+
+std::size_t Journal::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return recordCount;
+}
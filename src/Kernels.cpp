@@ -0,0 +1,227 @@
+#include "../include/Kernels.h"
+#include <algorithm>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SMS_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+// Descending cut-offs; a value's bucket is the number of cut-offs it is below,
+// which matches the if/else chains in the reports (>= 90 is A, >= 80 is B, ...)
+static const float gradeCutoffs[5] = {90, 80, 70, 60, 50};
+static const float attendanceCutoffs[3] = {90, 80, 75};
+
+static bool compareScalar(float value, Kernels::Compare op, float threshold) {
+    switch (op) {
+        case Kernels::Compare::Less: return value < threshold;
+        case Kernels::Compare::LessEqual: return value <= threshold;
+        case Kernels::Compare::Greater: return value > threshold;
+        default: return value >= threshold;
+    }
+}
+
+// Scalar versions, also used for the tail after the last full vector
+static void selectMaskScalar(const float* values, std::size_t begin, std::size_t n,
+                             Kernels::Compare op, float threshold, std::uint64_t* mask) {
+    for (std::size_t i = begin; i < n; i++) {
+        if (compareScalar(values[i], op, threshold)) {
+            mask[i / 64] |= std::uint64_t(1) << (i % 64);
+        }
+    }
+}
+
+// below[k] counts values under cut-off k; the buckets are differences of those counts
+static void countBelowScalar(const float* grades, const float* attendance, std::size_t begin, std::size_t n,
+                             std::size_t gradeBelow[5], std::size_t attendanceBelow[3]) {
+    for (std::size_t i = begin; i < n; i++) {
+        for (int k = 0; k < 5; k++) {
+            gradeBelow[k] += grades[i] < gradeCutoffs[k];
+        }
+        for (int k = 0; k < 3; k++) {
+            attendanceBelow[k] += attendance[i] < attendanceCutoffs[k];
+        }
+    }
+}
+
+#ifdef SMS_X86_KERNELS
+__attribute__((target("avx2")))
+static void selectMaskAvx2(const float* values, std::size_t n, Kernels::Compare op, float threshold,
+                           std::uint64_t* mask) {
+    const __m256 limit = _mm256_set1_ps(threshold);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 v = _mm256_loadu_ps(values + i);
+        __m256 hit;
+        switch (op) {
+            case Kernels::Compare::Less: hit = _mm256_cmp_ps(v, limit, _CMP_LT_OQ); break;
+            case Kernels::Compare::LessEqual: hit = _mm256_cmp_ps(v, limit, _CMP_LE_OQ); break;
+            case Kernels::Compare::Greater: hit = _mm256_cmp_ps(v, limit, _CMP_GT_OQ); break;
+            default: hit = _mm256_cmp_ps(v, limit, _CMP_GE_OQ); break;
+        }
+        std::uint64_t bits = static_cast<std::uint32_t>(_mm256_movemask_ps(hit));
+        mask[i / 64] |= bits << (i % 64);
+    }
+    selectMaskScalar(values, i, n, op, threshold, mask);
+}
+
+__attribute__((target("avx2")))
+static void countBelowAvx2(const float* grades, const float* attendance, std::size_t n,
+                           std::size_t gradeBelow[5], std::size_t attendanceBelow[3]) {
+    // Compare results are -1 per lane, so subtracting them counts hits in 32-bit lanes
+    __m256i gradeAcc[5], attendanceAcc[3];
+    for (auto& acc : gradeAcc) acc = _mm256_setzero_si256();
+    for (auto& acc : attendanceAcc) acc = _mm256_setzero_si256();
+
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 g = _mm256_loadu_ps(grades + i);
+        __m256 a = _mm256_loadu_ps(attendance + i);
+        for (int k = 0; k < 5; k++) {
+            __m256 hit = _mm256_cmp_ps(g, _mm256_set1_ps(gradeCutoffs[k]), _CMP_LT_OQ);
+            gradeAcc[k] = _mm256_sub_epi32(gradeAcc[k], _mm256_castps_si256(hit));
+        }
+        for (int k = 0; k < 3; k++) {
+            __m256 hit = _mm256_cmp_ps(a, _mm256_set1_ps(attendanceCutoffs[k]), _CMP_LT_OQ);
+            attendanceAcc[k] = _mm256_sub_epi32(attendanceAcc[k], _mm256_castps_si256(hit));
+        }
+    }
+
+    alignas(32) std::uint32_t lanes[8];
+    for (int k = 0; k < 5; k++) {
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), gradeAcc[k]);
+        for (std::uint32_t lane : lanes) gradeBelow[k] += lane;
+    }
+    for (int k = 0; k < 3; k++) {
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), attendanceAcc[k]);
+        for (std::uint32_t lane : lanes) attendanceBelow[k] += lane;
+    }
+    countBelowScalar(grades, attendance, i, n, gradeBelow, attendanceBelow);
+}
+
+__attribute__((target("sse2")))
+static void selectMaskSse2(const float* values, std::size_t n, Kernels::Compare op, float threshold,
+                           std::uint64_t* mask) {
+    const __m128 limit = _mm_set1_ps(threshold);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 v = _mm_loadu_ps(values + i);
+        __m128 hit;
+        switch (op) {
+            case Kernels::Compare::Less: hit = _mm_cmplt_ps(v, limit); break;
+            case Kernels::Compare::LessEqual: hit = _mm_cmple_ps(v, limit); break;
+            case Kernels::Compare::Greater: hit = _mm_cmpgt_ps(v, limit); break;
+            default: hit = _mm_cmpge_ps(v, limit); break;
+        }
+        std::uint64_t bits = static_cast<std::uint32_t>(_mm_movemask_ps(hit));
+        mask[i / 64] |= bits << (i % 64);
+    }
+    selectMaskScalar(values, i, n, op, threshold, mask);
+}
+
+__attribute__((target("sse2")))
+static void countBelowSse2(const float* grades, const float* attendance, std::size_t n,
+                           std::size_t gradeBelow[5], std::size_t attendanceBelow[3]) {
+    __m128i gradeAcc[5], attendanceAcc[3];
+    for (auto& acc : gradeAcc) acc = _mm_setzero_si128();
+    for (auto& acc : attendanceAcc) acc = _mm_setzero_si128();
+
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 g = _mm_loadu_ps(grades + i);
+        __m128 a = _mm_loadu_ps(attendance + i);
+        for (int k = 0; k < 5; k++) {
+            __m128 hit = _mm_cmplt_ps(g, _mm_set1_ps(gradeCutoffs[k]));
+            gradeAcc[k] = _mm_sub_epi32(gradeAcc[k], _mm_castps_si128(hit));
+        }
+        for (int k = 0; k < 3; k++) {
+            __m128 hit = _mm_cmplt_ps(a, _mm_set1_ps(attendanceCutoffs[k]));
+            attendanceAcc[k] = _mm_sub_epi32(attendanceAcc[k], _mm_castps_si128(hit));
+        }
+    }
+
+    alignas(16) std::uint32_t lanes[4];
+    for (int k = 0; k < 5; k++) {
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), gradeAcc[k]);
+        for (std::uint32_t lane : lanes) gradeBelow[k] += lane;
+    }
+    for (int k = 0; k < 3; k++) {
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), attendanceAcc[k]);
+        for (std::uint32_t lane : lanes) attendanceBelow[k] += lane;
+    }
+    countBelowScalar(grades, attendance, i, n, gradeBelow, attendanceBelow);
+}
+#endif
+
+namespace {
+    enum class Isa { Scalar, Sse2, Avx2 };
+
+    // Asked once; CPUID does not change while the program runs
+    Isa detectIsa() {
+#ifdef SMS_X86_KERNELS
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return Isa::Avx2;
+        }
+        if (__builtin_cpu_supports("sse2")) {
+            return Isa::Sse2;
+        }
+#endif
+        return Isa::Scalar;
+    }
+
+    Isa activeIsa() {
+        static const Isa isa = detectIsa();
+        return isa;
+    }
+}
+
+void Kernels::selectMask(const float* values, std::size_t n, Compare op, float threshold,
+                         std::vector<std::uint64_t>& mask) {
+    mask.assign((n + 63) / 64, 0);
+    switch (activeIsa()) {
+#ifdef SMS_X86_KERNELS
+        case Isa::Avx2: selectMaskAvx2(values, n, op, threshold, mask.data()); return;
+        case Isa::Sse2: selectMaskSse2(values, n, op, threshold, mask.data()); return;
+#endif
+        default: selectMaskScalar(values, 0, n, op, threshold, mask.data()); return;
+    }
+}
+
+Kernels::RosterHistogram Kernels::rosterHistogram(const float* grades, const float* attendance, std::size_t n) {
+    // Counts are gathered in chunks so the 32-bit vector lanes can never overflow
+    const std::size_t chunk = std::size_t(1) << 28;
+    std::size_t gradeBelow[5] = {};
+    std::size_t attendanceBelow[3] = {};
+    for (std::size_t begin = 0; begin < n; begin += chunk) {
+        std::size_t count = std::min(chunk, n - begin);
+        switch (activeIsa()) {
+#ifdef SMS_X86_KERNELS
+            case Isa::Avx2: countBelowAvx2(grades + begin, attendance + begin, count, gradeBelow, attendanceBelow); break;
+            case Isa::Sse2: countBelowSse2(grades + begin, attendance + begin, count, gradeBelow, attendanceBelow); break;
+#endif
+            default: countBelowScalar(grades + begin, attendance + begin, 0, count, gradeBelow, attendanceBelow); break;
+        }
+    }
+
+    RosterHistogram histogram;
+    histogram.grade[0] = n - gradeBelow[0];
+    for (int k = 1; k < 5; k++) {
+        histogram.grade[k] = gradeBelow[k - 1] - gradeBelow[k];
+    }
+    histogram.grade[5] = gradeBelow[4];
+
+    histogram.attendance[0] = n - attendanceBelow[0];
+    for (int k = 1; k < 3; k++) {
+        histogram.attendance[k] = attendanceBelow[k - 1] - attendanceBelow[k];
+    }
+    histogram.attendance[3] = attendanceBelow[2];
+    return histogram;
+}
+
+const char* Kernels::activeInstructionSet() {
+    switch (activeIsa()) {
+        case Isa::Avx2: return "avx2";
+        case Isa::Sse2: return "sse2";
+        default: return "scalar";
+    }
+}
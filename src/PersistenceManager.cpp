@@ -0,0 +1,104 @@
+#include "../include/PersistenceManager.h"
+#include "../include/CsvReader.h"
+#include <cstdio>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <unistd.h>
+
+bool FlushPolicy::parse(const std::string& text, FlushPolicy& policy) {
+    if (text == "immediate") {
+        policy = {Immediate, 1};
+        return true;
+    }
+    if (text == "exit") {
+        policy = {OnExit, 0};
+        return true;
+    }
+
+    std::size_t colon = text.find(':');
+    if (colon == std::string::npos) {
+        return false;
+    }
+    std::string kind = text.substr(0, colon);
+    int amount;
+    if (!Csv::parseInt(std::string_view(text).substr(colon + 1), amount) || amount < 1) {
+        return false;
+    }
+    if (kind == "ops") {
+        policy = {EveryOps, static_cast<std::size_t>(amount)};
+        return true;
+    }
+    if (kind == "ms") {
+        policy = {EveryMillis, static_cast<std::size_t>(amount)};
+        return true;
+    }
+    return false;
+}
+
+void PersistenceManager::recordChange(unsigned tables) {
+    dirty |= tables;
+    pendingOps++;
+}
+
+bool PersistenceManager::isFlushDue() const {
+    if (dirty == 0) {
+        return false;
+    }
+    switch (policy.mode) {
+        case FlushPolicy::Immediate:
+            return true;
+        case FlushPolicy::EveryOps:
+            return pendingOps >= policy.amount;
+        case FlushPolicy::EveryMillis:
+            return std::chrono::steady_clock::now() - lastFlush >= std::chrono::milliseconds(policy.amount);
+        case FlushPolicy::OnExit:
+            return false;
+    }
+    return false;
+}
+
+void PersistenceManager::markFlushed() {
+    dirty = 0;
+    pendingOps = 0;
+    lastFlush = std::chrono::steady_clock::now();
+}
+
+// Opens a file or directory just to fsync it; an ofstream has no way to do that
+static bool syncPath(const std::string& path, int flags) {
+    int fd = ::open(path.c_str(), flags);
+    if (fd < 0) {
+        return false;
+    }
+    bool synced = ::fsync(fd) == 0;
+    ::close(fd);
+    return synced;
+}
+
+bool PersistenceManager::writeAtomically(const std::string& path, const std::function<void(std::ostream&)>& write) {
+    std::string tempPath = path + ".tmp";
+    {
+        std::ofstream outFile(tempPath, std::ios::binary | std::ios::trunc);
+        if (!outFile) {
+            return false;
+        }
+        write(outFile);
+        outFile.close();
+        if (!outFile) {
+            std::remove(tempPath.c_str());
+            return false;
+        }
+    }
+
+    // The contents have to be on disk before the rename, or a power loss can leave the
+    // new name pointing at an empty file; the directory is synced so the rename itself sticks
+    if (!syncPath(tempPath, O_RDONLY)) {
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        return false;
+    }
+    std::string directory = std::filesystem::path(path).parent_path().string();
+    return syncPath(directory.empty() ? "." : directory, O_RDONLY | O_DIRECTORY);
+}
@@ -0,0 +1,50 @@
+#include "../include/RecordArena.h"
+
+CountingResource::CountingResource(std::pmr::memory_resource* upstream) : upstream(upstream) {
+}
+
+void* CountingResource::do_allocate(std::size_t size, std::size_t alignment) {
+    void* pointer = upstream->allocate(size, alignment);
+    blocks.fetch_add(1, std::memory_order_relaxed);
+    bytes.fetch_add(size, std::memory_order_relaxed);
+    return pointer;
+}
+
+void CountingResource::do_deallocate(void* pointer, std::size_t size, std::size_t alignment) {
+    upstream->deallocate(pointer, size, alignment);
+    blocks.fetch_sub(1, std::memory_order_relaxed);
+    bytes.fetch_sub(size, std::memory_order_relaxed);
+}
+
+bool CountingResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+void* DroppableResource::do_allocate(std::size_t size, std::size_t alignment) {
+    return upstream->allocate(size, alignment);
+}
+
+void DroppableResource::do_deallocate(void* pointer, std::size_t size, std::size_t alignment) {
+    if (!dropping.load(std::memory_order_relaxed)) {
+        upstream->deallocate(pointer, size, alignment);
+    }
+}
+
+bool DroppableResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+RecordResources RecordArena::newChunk(std::size_t expectedBytes) {
+    // Small hints are left to the resource's own growth policy
+    const std::size_t minFirstBlock = 4096;
+    if (expectedBytes < minFirstBlock) {
+        stringPools.push_back(std::make_unique<std::pmr::monotonic_buffer_resource>(&heap));
+    } else {
+        stringPools.push_back(std::make_unique<std::pmr::monotonic_buffer_resource>(expectedBytes, &heap));
+    }
+
+    RecordResources resources;
+    resources.strings = stringPools.back().get();
+    resources.lists = &lists;
+    return resources;
+}
@@ -0,0 +1,125 @@
+#include "../include/ReportWriter.h"
+#include "../include/Utils.h"
+#include <charconv>
+#include <cstring>
+#include <iostream>
+
+ReportWriter::ReportWriter(std::ostream& out, std::size_t bufferBytes)
+    : out(out), buffer(bufferBytes), colors(UI::usesColors(out)) {}
+
+ReportWriter::~ReportWriter() {
+    flush();
+}
+
+// Makes room for bytes more characters, draining the buffer to the stream when it is full
+// A single value bigger than the whole buffer grows it instead
+char* ReportWriter::reserve(std::size_t bytes) {
+    if (used + bytes > buffer.size()) {
+        drain();
+        if (bytes > buffer.size()) {
+            buffer.resize(bytes);
+        }
+    }
+    return buffer.data() + used;
+}
+
+void ReportWriter::pad(std::size_t written, std::size_t width) {
+    if (written < width) {
+        std::memset(reserve(width - written), ' ', width - written);
+        used += width - written;
+    }
+}
+
+ReportWriter& ReportWriter::text(std::string_view value) {
+    std::memcpy(reserve(value.size()), value.data(), value.size());
+    used += value.size();
+    return *this;
+}
+
+ReportWriter& ReportWriter::color(const std::string& code) {
+    if (colors) {
+        text(code);
+    }
+    return *this;
+}
+
+ReportWriter& ReportWriter::cell(std::string_view value, std::size_t width) {
+    text(value);
+    pad(value.size(), width);
+    return *this;
+}
+
+ReportWriter& ReportWriter::cell(int value, std::size_t width) {
+    char* start = reserve(16);
+    auto result = std::to_chars(start, start + 16, value);
+    used += result.ptr - start;
+    pad(result.ptr - start, width);
+    return *this;
+}
+
+ReportWriter& ReportWriter::cell(std::size_t value, std::size_t width) {
+    char* start = reserve(24);
+    auto result = std::to_chars(start, start + 24, value);
+    used += result.ptr - start;
+    pad(result.ptr - start, width);
+    return *this;
+}
+
+ReportWriter& ReportWriter::cell(float value, std::size_t width) {
+    // A stream prints floats widened to double with six significant digits, the same as %g
+    const std::size_t maxChars = 32;
+    char* start = reserve(maxChars);
+    auto result = std::to_chars(start, start + maxChars, static_cast<double>(value), std::chars_format::general, 6);
+    used += result.ptr - start;
+    pad(result.ptr - start, width);
+    return *this;
+}
+
+// Formats into a scratch buffer first, since the padding goes in front of the number
+ReportWriter& ReportWriter::rightCell(std::size_t value, std::size_t width) {
+    char digits[24];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    std::size_t length = result.ptr - digits;
+    pad(length, width);
+    return text(std::string_view(digits, length));
+}
+
+ReportWriter& ReportWriter::rightCell(double value, std::size_t width, int precision) {
+    char digits[64];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value, std::chars_format::fixed, precision);
+    if (result.ec != std::errc()) {
+        return rightCell(std::size_t(0), width);
+    }
+    std::size_t length = result.ptr - digits;
+    pad(length, width);
+    return text(std::string_view(digits, length));
+}
+
+ReportWriter& ReportWriter::endLine() {
+    *reserve(1) = '\n';
+    used++;
+    return *this;
+}
+
+void ReportWriter::title(std::string_view value) {
+    const std::size_t width = 50;
+    std::size_t padding = value.size() < width ? (width - value.size()) / 2 : 0;
+    color(Color::cyan).color(Color::bold);
+    text(std::string(width, '=')).endLine();
+    pad(0, padding);
+    text(value).endLine();
+    text(std::string(width, '=')).endLine();
+    color(Color::reset).endLine();
+}
+
+void ReportWriter::drain() {
+    if (used > 0) {
+        out.write(buffer.data(), static_cast<std::streamsize>(used));
+        used = 0;
+    }
+}
+
+void ReportWriter::flush() {
+    drain();
+    out.flush();
+}
@@ -0,0 +1,62 @@
+#include "../include/SeatReservations.h"
+#include <algorithm>
+
+void SeatReservations::track(const std::string& code, int capacity, int enrolled) {
+    auto& seats = courses[code];
+    if (!seats) {
+        seats = std::make_unique<CourseSeats>();
+    }
+    seats->capacity = capacity;
+    seats->used.store(enrolled);
+}
+
+void SeatReservations::untrack(const std::string& code) {
+    courses.erase(code);
+}
+
+SeatReservations::CourseSeats* SeatReservations::find(const std::string& code) const {
+    auto it = courses.find(code);
+    return it == courses.end() ? nullptr : it->second.get();
+}
+
+bool SeatReservations::tryTake(CourseSeats& seats) {
+    // Old data files can hold more students than the capacity, so the check is "<", not "!="
+    int used = seats.used.load(std::memory_order_relaxed);
+    while (used < seats.capacity) {
+        if (seats.used.compare_exchange_weak(used, used + 1, std::memory_order_acq_rel)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void SeatReservations::release(CourseSeats& seats) {
+    seats.used.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void SeatReservations::joinWaitlist(CourseSeats& seats, int rollNo) {
+    std::lock_guard<std::mutex> lock(seats.waitlistMutex);
+    if (std::find(seats.waitlist.begin(), seats.waitlist.end(), rollNo) == seats.waitlist.end()) {
+        seats.waitlist.push_back(rollNo);
+    }
+}
+
+bool SeatReservations::leaveWaitlist(CourseSeats& seats, int rollNo) {
+    std::lock_guard<std::mutex> lock(seats.waitlistMutex);
+    auto it = std::find(seats.waitlist.begin(), seats.waitlist.end(), rollNo);
+    if (it == seats.waitlist.end()) {
+        return false;
+    }
+    seats.waitlist.erase(it);
+    return true;
+}
+
+bool SeatReservations::promote(CourseSeats& seats, int& rollNo) {
+    std::lock_guard<std::mutex> lock(seats.waitlistMutex);
+    if (seats.waitlist.empty() || !tryTake(seats)) {
+        return false;
+    }
+    rollNo = seats.waitlist.front();
+    seats.waitlist.pop_front();
+    return true;
+}
@@ -0,0 +1,274 @@
+#include "../include/Snapshot.h"
+#include "../include/CsvReader.h"
+#include "../include/PersistenceManager.h"
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+#include <memory_resource>
+#include <unordered_map>
+
+namespace {
+    const char magic[8] = {'S', 'M', 'S', 'S', 'N', 'A', 'P', '\0'};
+    const std::uint32_t byteOrderTag = 0x01020304;
+
+    struct Header {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t byteOrder;
+        std::uint64_t studentCount;
+        std::uint64_t courseCount;
+        std::uint64_t enrollmentCount;
+        std::uint64_t heapSize;
+    };
+
+    struct StringRef {
+        std::uint32_t offset;
+        std::uint32_t length;
+    };
+
+    std::size_t padded(std::size_t bytes) { return (bytes + 7) & ~std::size_t(7); }
+
+    // Collects the columns in memory so every section goes out with one write
+    class SectionWriter {
+    private:
+        std::string buffer;
+
+    public:
+        template <typename T>
+        void column(const std::vector<T>& values) {
+            buffer.append(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+            buffer.resize(padded(buffer.size()), '\0');
+        }
+
+        const std::string& bytes() const { return buffer; }
+    };
+
+    StringRef intern(std::string& heap, std::string_view value) {
+        StringRef ref{static_cast<std::uint32_t>(heap.size()), static_cast<std::uint32_t>(value.size())};
+        heap += value;
+        return ref;
+    }
+
+    // The interned columns put each distinct value in the heap once and share its ref
+    // Map nodes come from a monotonic arena, so a million distinct values cost a handful
+    // of block allocations instead of one per value
+    class SharedRefs {
+    private:
+        std::pmr::monotonic_buffer_resource arena;
+        std::pmr::unordered_map<StringId, StringRef> refs{&arena};
+
+    public:
+        StringRef add(std::string& heap, StringId id, std::string_view value) {
+            auto inserted = refs.try_emplace(id);
+            if (inserted.second) {
+                inserted.first->second = intern(heap, value);
+            }
+            return inserted.first->second;
+        }
+    };
+
+    // Bounds checked reader over the mapped file
+    class SectionReader {
+    private:
+        const char* cursor;
+        const char* end;
+
+    public:
+        SectionReader(const char* begin, const char* end) : cursor(begin), end(end) {}
+
+        template <typename T>
+        const T* column(std::size_t count) {
+            if (count > static_cast<std::size_t>(end - cursor) / sizeof(T)) {
+                return nullptr;
+            }
+            std::size_t bytes = padded(count * sizeof(T));
+            if (static_cast<std::size_t>(end - cursor) < bytes) {
+                return nullptr;
+            }
+            const T* values = reinterpret_cast<const T*>(cursor);
+            cursor += bytes;
+            return values;
+        }
+
+        const char* position() const { return cursor; }
+    };
+}
+
+bool Snapshot::encode(const SlotMap<Student>& students, const SlotMap<Course>& courses, std::string& bytes) {
+    std::string heap;
+    SectionWriter body;
+
+    std::size_t n = students.size();
+    std::vector<std::int32_t> ids(n), rolls(n);
+    std::vector<float> grades(n), attendance(n);
+    std::vector<StringRef> names(n), emails(n), phones(n), addresses(n);
+    std::size_t enrollmentCount = 0;
+    SharedRefs sharedAddresses;
+    for (std::size_t i = 0; i < n; i++) {
+        const Student& s = students[i];
+        ids[i] = s.getId();
+        rolls[i] = s.getRollNo();
+        grades[i] = s.getGrade();
+        attendance[i] = s.getAttendance();
+        names[i] = intern(heap, s.getName());
+        emails[i] = intern(heap, s.getEmail());
+        phones[i] = intern(heap, s.getPhone());
+        addresses[i] = sharedAddresses.add(heap, s.getAddressId(), s.getAddress());
+        enrollmentCount += s.getEnrolledCourses().size();
+    }
+    body.column(ids);
+    body.column(rolls);
+    body.column(grades);
+    body.column(attendance);
+    body.column(names);
+    body.column(emails);
+    body.column(phones);
+    body.column(addresses);
+
+    std::size_t m = courses.size();
+    std::vector<std::int32_t> courseIds(m), credits(m), capacities(m);
+    std::vector<StringRef> codes(m), courseNames(m), instructors(m);
+    SharedRefs sharedNames, sharedInstructors;
+    for (std::size_t i = 0; i < m; i++) {
+        const Course& c = courses[i];
+        courseIds[i] = c.getId();
+        credits[i] = c.getCredits();
+        capacities[i] = c.getMaxCapacity();
+        codes[i] = intern(heap, c.getCode());
+        courseNames[i] = sharedNames.add(heap, c.getNameId(), c.getName());
+        instructors[i] = sharedInstructors.add(heap, c.getInstructorId(), c.getInstructor());
+    }
+    body.column(courseIds);
+    body.column(credits);
+    body.column(capacities);
+    body.column(codes);
+    body.column(courseNames);
+    body.column(instructors);
+
+    std::vector<std::int32_t> enrolledStudents, enrolledCourses;
+    enrolledStudents.reserve(enrollmentCount);
+    enrolledCourses.reserve(enrollmentCount);
+    for (const auto& student : students) {
+        for (const auto& handle : student.getEnrolledCourses()) {
+            const Course* course = courses.get(handle);
+            if (course) {
+                enrolledStudents.push_back(student.getId());
+                enrolledCourses.push_back(course->getId());
+            }
+        }
+    }
+    body.column(enrolledStudents);
+    body.column(enrolledCourses);
+
+    if (heap.size() > UINT32_MAX) {
+        return false;
+    }
+
+    Header header;
+    std::memcpy(header.magic, magic, sizeof(magic));
+    header.version = version;
+    header.byteOrder = byteOrderTag;
+    header.studentCount = n;
+    header.courseCount = m;
+    header.enrollmentCount = enrolledStudents.size();
+    header.heapSize = heap.size();
+
+    bytes.clear();
+    bytes.reserve(sizeof(header) + body.bytes().size() + heap.size());
+    bytes.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    bytes.append(body.bytes().data(), body.bytes().size());
+    bytes.append(heap);
+    return true;
+}
+
+bool Snapshot::write(const std::string& path, const SlotMap<Student>& students, const SlotMap<Course>& courses) {
+    std::string bytes;
+    if (!encode(students, courses, bytes)) {
+        return false;
+    }
+    return PersistenceManager::writeAtomically(path, [&bytes](std::ostream& out) {
+        out.write(bytes.data(), bytes.size());
+    });
+}
+
+bool Snapshot::read(const std::string& path, ParsedTables& tables) {
+    MappedFile file(path);
+    if (!file.isOpen() || file.size() < sizeof(Header)) {
+        return false;
+    }
+
+    Header header;
+    std::memcpy(&header, file.begin(), sizeof(header));
+    if (std::memcmp(header.magic, magic, sizeof(magic)) != 0 || header.version != version ||
+        header.byteOrder != byteOrderTag) {
+        return false;
+    }
+
+    SectionReader reader(file.begin() + sizeof(Header), file.end());
+    std::size_t n = header.studentCount;
+    std::size_t m = header.courseCount;
+    std::size_t e = header.enrollmentCount;
+
+    const std::int32_t* ids = reader.column<std::int32_t>(n);
+    const std::int32_t* rolls = reader.column<std::int32_t>(n);
+    const float* grades = reader.column<float>(n);
+    const float* attendance = reader.column<float>(n);
+    const StringRef* names = reader.column<StringRef>(n);
+    const StringRef* emails = reader.column<StringRef>(n);
+    const StringRef* phones = reader.column<StringRef>(n);
+    const StringRef* addresses = reader.column<StringRef>(n);
+    const std::int32_t* courseIds = reader.column<std::int32_t>(m);
+    const std::int32_t* credits = reader.column<std::int32_t>(m);
+    const std::int32_t* capacities = reader.column<std::int32_t>(m);
+    const StringRef* codes = reader.column<StringRef>(m);
+    const StringRef* courseNames = reader.column<StringRef>(m);
+    const StringRef* instructors = reader.column<StringRef>(m);
+    const std::int32_t* enrolledStudents = reader.column<std::int32_t>(e);
+    const std::int32_t* enrolledCourses = reader.column<std::int32_t>(e);
+    const char* heap = reader.position();
+
+    if (!ids || !rolls || !grades || !attendance || !names || !emails || !phones || !addresses ||
+        !courseIds || !credits || !capacities || !codes || !courseNames || !instructors ||
+        !enrolledStudents || !enrolledCourses || static_cast<std::size_t>(file.end() - heap) < header.heapSize) {
+        return false;
+    }
+
+    bool refsValid = true;
+    auto text = [&](const StringRef& ref) {
+        if (static_cast<std::uint64_t>(ref.offset) + ref.length > header.heapSize) {
+            refsValid = false;
+            return std::string_view();
+        }
+        return std::string_view(heap + ref.offset, ref.length);
+    };
+
+    ParsedTables loaded;
+    loaded.studentsFound = loaded.coursesFound = loaded.enrollmentsFound = true;
+    loaded.studentChunks.resize(1);
+    loaded.courseChunks.resize(1);
+    loaded.enrollmentChunks.resize(1);
+
+    // One chunk, so one string pool; the records copy their text out of the mapped heap
+    RecordResources resources = loaded.arena->newChunk(header.heapSize);
+    loaded.studentChunks[0].reserve(n);
+    for (std::size_t i = 0; i < n; i++) {
+        loaded.studentChunks[0].emplace_back(ids[i], text(names[i]), rolls[i], grades[i], attendance[i],
+                                             text(emails[i]), text(phones[i]), text(addresses[i]), resources);
+    }
+    loaded.courseChunks[0].reserve(m);
+    for (std::size_t i = 0; i < m; i++) {
+        loaded.courseChunks[0].emplace_back(courseIds[i], text(codes[i]), text(courseNames[i]),
+                                            text(instructors[i]), credits[i], capacities[i], resources);
+    }
+    loaded.enrollmentChunks[0].reserve(e);
+    for (std::size_t i = 0; i < e; i++) {
+        loaded.enrollmentChunks[0].emplace_back(enrolledStudents[i], enrolledCourses[i]);
+    }
+
+    if (!refsValid) {
+        return false;
+    }
+    tables = std::move(loaded);
+    return true;
+}
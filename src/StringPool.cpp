@@ -0,0 +1,88 @@
+#include "../include/StringPool.h"
+#include <cstring>
+#include <functional>
+#include <utility>
+
+// Finds the segment and the slot inside it for the index-th value of a shard
+void StringPool::locate(std::uint32_t index, std::size_t& segment, std::size_t& offset) {
+    std::uint32_t scaled = (index >> 6) + 1;
+    segment = 31 - __builtin_clz(scaled);
+    offset = index - ((std::size_t(1) << segment) - 1) * 64;
+}
+
+StringId StringPool::intern(std::string_view value) {
+    if (value.empty()) {
+        return 0;
+    }
+
+    std::size_t shardIndex = std::hash<std::string_view>()(value) & (ShardCount - 1);
+    Shard& shard = shards[shardIndex];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.ids.find(value);
+    if (it != shard.ids.end()) {
+        return it->second;
+    }
+
+    std::size_t segment;
+    std::size_t offset;
+    locate(shard.size, segment, offset);
+    if (!shard.segments[segment]) {
+        shard.segments[segment].reset(new std::string_view[std::size_t(64) << segment]);
+    }
+
+    char* copy = static_cast<char*>(shard.text.allocate(value.size(), 1));
+    std::memcpy(copy, value.data(), value.size());
+    std::string_view stored(copy, value.size());
+    shard.segments[segment][offset] = stored;
+
+    StringId id = static_cast<StringId>(((std::size_t(shard.size) << ShardBits) | shardIndex) + 1);
+    shard.ids.emplace(stored, id);
+    shard.size++;
+    shard.textBytes += value.size();
+    return id;
+}
+
+std::string_view StringPool::text(StringId id) const {
+    if (id == 0) {
+        return {};
+    }
+
+    std::size_t segment;
+    std::size_t offset;
+    const Shard& shard = shards[(id - 1) & (ShardCount - 1)];
+    locate((id - 1) >> ShardBits, segment, offset);
+    return shard.segments[segment][offset];
+}
+
+StringPoolStats StringPool::stats() {
+    // Map nodes hold the key, the id, the next pointer and the cached hash
+    const std::size_t nodeBytes = sizeof(std::pair<const std::string_view, StringId>) + 2 * sizeof(void*);
+
+    StringPoolStats stats;
+    for (Shard& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        stats.distinct += shard.size;
+        stats.textBytes += shard.textBytes;
+        stats.indexBytes += shard.ids.size() * nodeBytes + shard.ids.bucket_count() * sizeof(void*);
+        for (std::size_t segment = 0; segment < SegmentCount && shard.segments[segment]; segment++) {
+            stats.indexBytes += (std::size_t(64) << segment) * sizeof(std::string_view);
+        }
+    }
+    return stats;
+}
+
+StringPool& StringPool::addresses() {
+    static StringPool pool;
+    return pool;
+}
+
+StringPool& StringPool::courseNames() {
+    static StringPool pool;
+    return pool;
+}
+
+StringPool& StringPool::instructors() {
+    static StringPool pool;
+    return pool;
+}
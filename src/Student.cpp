@@ -1,28 +1,33 @@
 #include "../include/Student.h"
 #include "../include/Course.h"
+#include "../include/CsvWriter.h"
+#include "../include/ReportWriter.h"
 
 // I've implemented two constructors here - one simple and one with all details
 // This approach gives me flexibility when creating student objects
-Student::Student(std::string n, int r, float g, float a) 
+Student::Student(std::string_view n, int r, float g, float a) 
     : id(0), name(n), rollNo(r), grade(g), attendance(a), 
-      email(""), phone(""), address("") {}
+      email(""), phone(""), address(0) {}
 
-Student::Student(int id, std::string n, int r, float g, float a, 
-                 std::string email, std::string phone, std::string address)
-    : id(id), name(n), rollNo(r), grade(g), attendance(a), 
-      email(email), phone(phone), address(address) {}
+Student::Student(int id, std::string_view n, int r, float g, float a, 
+                 std::string_view email, std::string_view phone, std::string_view address,
+                 RecordResources resources)
+    : id(id), name(n, resources.strings), rollNo(r), grade(g), attendance(a), 
+      email(email, resources.strings), phone(phone, resources.strings), address(StringPool::addresses().intern(address)),
+      enrolledCourses(resources.lists) {}
 
 // My getter methods - I'm using const qualifiers to ensure these don't modify the object
 // This is a good practice I learned to maintain data integrity
 int Student::getId() const { return id; }
-std::string Student::getName() const { return name; }
+std::string_view Student::getName() const { return name; }
 int Student::getRollNo() const { return rollNo; }
 float Student::getGrade() const { return grade; }
 float Student::getAttendance() const { return attendance; }
-std::string Student::getEmail() const { return email; }
-std::string Student::getPhone() const { return phone; }
-std::string Student::getAddress() const { return address; }
-std::vector<Course*> Student::getEnrolledCourses() const { return enrolledCourses; }
+std::string_view Student::getEmail() const { return email; }
+std::string_view Student::getPhone() const { return phone; }
+std::string_view Student::getAddress() const { return StringPool::addresses().text(address); }
+StringId Student::getAddressId() const { return address; }
+const HandleSet<Course>& Student::getEnrolledCourses() const { return enrolledCourses; }
 
 // Setter implementations
 void Student::setId(int id) { this->id = id; }
@@ -45,62 +50,58 @@ void Student::setAttendance(float a) {
 
 void Student::setEmail(std::string email) { this->email = email; }
 void Student::setPhone(std::string phone) { this->phone = phone; }
-void Student::setAddress(std::string address) { this->address = address; }
+void Student::setAddress(std::string address) { this->address = StringPool::addresses().intern(address); }
 
 // Course management methods
-void Student::enrollCourse(Course* course) {
-    if (!isEnrolledIn(course)) {
-        enrolledCourses.push_back(course);
-    }
+void Student::enrollCourse(CourseHandle course) {
+    enrolledCourses.insert(course);
 }
 
-void Student::dropCourse(Course* course) {
-    for (auto it = enrolledCourses.begin(); it != enrolledCourses.end(); ++it) {
-        if (*it == course) {
-            enrolledCourses.erase(it);
-            return;
-        }
-    }
+void Student::dropCourse(CourseHandle course) {
+    enrolledCourses.erase(course);
 }
 
-bool Student::isEnrolledIn(Course* course) const {
-    for (const auto& c : enrolledCourses) {
-        if (c == course) {
-            return true;
-        }
-    }
-    return false;
+bool Student::isEnrolledIn(CourseHandle course) const {
+    return enrolledCourses.contains(course);
+}
+
+void Student::reserveCourses(std::size_t count) {
+    enrolledCourses.reserve(count);
 }
 
 // Display methods
-void Student::display() const {
-    std::cout << "| " << std::left << std::setw(20) << name << " | "
-              << std::setw(8) << rollNo << " | "
-              << std::setw(5) << grade << " | "
-              << std::setw(10) << attendance << "% |" << std::endl;
+void Student::display(ReportWriter& out) const {
+    out.text("| ").cell(getName(), 20).text(" | ")
+       .cell(rollNo, 8).text(" | ")
+       .cell(grade, 5).text(" | ")
+       .cell(attendance, 10).text("% |").endLine();
 }
 
-void Student::displayDetailed() const {
-    std::cout << "+----------------------------------+\n";
-    std::cout << "| Student Details                  |\n";
-    std::cout << "+----------------------------------+\n";
-    std::cout << "| ID        : " << std::left << std::setw(23) << id << " |\n";
-    std::cout << "| Name      : " << std::left << std::setw(23) << name << " |\n";
-    std::cout << "| Roll No   : " << std::left << std::setw(23) << rollNo << " |\n";
-    std::cout << "| Grade     : " << std::left << std::setw(23) << grade << " |\n";
-    std::cout << "| Attendance: " << std::left << std::setw(22) << attendance << "% |\n";
-    std::cout << "| Email     : " << std::left << std::setw(23) << email << " |\n";
-    std::cout << "| Phone     : " << std::left << std::setw(23) << phone << " |\n";
-    std::cout << "| Address   : " << std::left << std::setw(23) << address << " |\n";
-    std::cout << "+----------------------------------+\n";
+void Student::displayDetailed(const SlotMap<Course>& courses, ReportWriter& out) const {
+    out.text("+----------------------------------+").endLine();
+    out.text("| Student Details                  |").endLine();
+    out.text("+----------------------------------+").endLine();
+    out.text("| ID        : ").cell(id, 23).text(" |").endLine();
+    out.text("| Name      : ").cell(getName(), 23).text(" |").endLine();
+    out.text("| Roll No   : ").cell(rollNo, 23).text(" |").endLine();
+    out.text("| Grade     : ").cell(grade, 23).text(" |").endLine();
+    out.text("| Attendance: ").cell(attendance, 22).text("% |").endLine();
+    out.text("| Email     : ").cell(getEmail(), 23).text(" |").endLine();
+    out.text("| Phone     : ").cell(getPhone(), 23).text(" |").endLine();
+    out.text("| Address   : ").cell(getAddress(), 23).text(" |").endLine();
+    out.text("+----------------------------------+").endLine();
     
     if (!enrolledCourses.empty()) {
-        std::cout << "| Enrolled Courses:                |\n";
-        std::cout << "+----------------------------------+\n";
-        for (const auto& course : enrolledCourses) {
-            std::cout << "| " << std::left << std::setw(32) << course->getCode() + " - " + course->getName() << " |\n";
+        out.text("| Enrolled Courses:                |").endLine();
+        out.text("+----------------------------------+").endLine();
+        for (const auto& handle : enrolledCourses) {
+            const Course* course = courses.get(handle);
+            if (course) {
+                out.text("| ").cell(std::string(course->getCode()) + " - " + std::string(course->getName()), 32)
+                   .text(" |").endLine();
+            }
         }
-        std::cout << "+----------------------------------+\n";
+        out.text("+----------------------------------+").endLine();
     }
 }
 
@@ -110,13 +111,14 @@ void Student::displayAttendance() const {
               << " | " << std::setw(10) << attendance << "% |" << std::endl;
 }
 
-std::string Student::toCSV() const {
-    return std::to_string(id) + "," +
-           name + "," +
-           std::to_string(rollNo) + "," +
-           std::to_string(grade) + "," +
-           std::to_string(attendance) + "," +
-           email + "," +
-           phone + "," +
-           address;
+void Student::writeCSV(CsvWriter& writer) const {
+    writer.field(id);
+    writer.field(name);
+    writer.field(rollNo);
+    writer.field(grade);
+    writer.field(attendance);
+    writer.field(email);
+    writer.field(phone);
+    writer.field(getAddress());
+    writer.endRow();
 }
@@ -0,0 +1,248 @@
+#include "../include/StudentApi.h"
+#include "../include/ConcurrentStudentManagement.h"
+#include "../include/CsvReader.h"
+#include <charconv>
+
+// Small JSON builder; the API only returns flat objects and arrays of them
+static void appendString(std::string& out, std::string_view text) {
+    out += '"';
+    for (char c : text) {
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    static const char hex[] = "0123456789abcdef";
+                    out += "\\u00";
+                    out += hex[(c >> 4) & 0xF];
+                    out += hex[c & 0xF];
+                } else {
+                    out += c;
+                }
+        }
+    }
+    out += '"';
+}
+
+static void appendNumber(std::string& out, float value) {
+    char buffer[32];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
+
+static void appendNumber(std::string& out, long long value) {
+    out += std::to_string(value);
+}
+
+static void appendKey(std::string& out, const char* key) {
+    out += '"';
+    out += key;
+    out += "\":";
+}
+
+static void appendStudent(std::string& out, const Student& student) {
+    out += "{";
+    appendKey(out, "id"); appendNumber(out, static_cast<long long>(student.getId()));
+    out += ','; appendKey(out, "rollNo"); appendNumber(out, static_cast<long long>(student.getRollNo()));
+    out += ','; appendKey(out, "name"); appendString(out, student.getName());
+    out += ','; appendKey(out, "grade"); appendNumber(out, student.getGrade());
+    out += ','; appendKey(out, "attendance"); appendNumber(out, student.getAttendance());
+    out += ','; appendKey(out, "email"); appendString(out, student.getEmail());
+    out += ','; appendKey(out, "phone"); appendString(out, student.getPhone());
+    out += ','; appendKey(out, "address"); appendString(out, student.getAddress());
+    out += '}';
+}
+
+static HttpResponse json(int status, std::string body) {
+    HttpResponse response;
+    response.status = status;
+    response.body = std::move(body);
+    return response;
+}
+
+static HttpResponse error(int status, const std::string& message) {
+    std::string body = "{";
+    appendKey(body, "error");
+    appendString(body, message);
+    body += '}';
+    return json(status, std::move(body));
+}
+
+static HttpResponse studentList(const std::vector<Student>& students) {
+    std::string body = "{";
+    appendKey(body, "count");
+    appendNumber(body, static_cast<long long>(students.size()));
+    body += ',';
+    appendKey(body, "students");
+    body += '[';
+    for (std::size_t i = 0; i < students.size(); i++) {
+        if (i > 0) body += ',';
+        appendStudent(body, students[i]);
+    }
+    body += "]}";
+    return json(200, std::move(body));
+}
+
+static bool intParam(const HttpRequest& request, const char* name, int& value) {
+    auto it = request.params.find(name);
+    return it != request.params.end() && Csv::parseInt(it->second, value);
+}
+
+static bool floatParam(const HttpRequest& request, const char* name, float& value) {
+    auto it = request.params.find(name);
+    return it != request.params.end() && Csv::parseFloat(it->second, value);
+}
+
+static HttpResponse getStudent(ConcurrentStudentManagement& store, const std::string& rollText) {
+    int rollNo;
+    if (!Csv::parseInt(rollText, rollNo)) {
+        return error(400, "roll number must be an integer");
+    }
+    std::optional<Student> student = store.findStudent(rollNo);
+    if (!student) {
+        return error(404, "Student with roll number " + rollText + " not found!");
+    }
+
+    std::string body;
+    appendStudent(body, *student);
+    body.pop_back();
+    body += ',';
+    appendKey(body, "courses");
+    body += '[';
+    std::vector<std::string> codes = store.getEnrolledCourseCodes(rollNo);
+    for (std::size_t i = 0; i < codes.size(); i++) {
+        if (i > 0) body += ',';
+        appendString(body, codes[i]);
+    }
+    body += "]}";
+    return json(200, std::move(body));
+}
+
+static HttpResponse getCourse(ConcurrentStudentManagement& store, const std::string& code) {
+    std::optional<Course> course = store.findCourse(code);
+    if (!course) {
+        return error(404, "Course with code " + code + " not found!");
+    }
+
+    std::string body = "{";
+    appendKey(body, "id"); appendNumber(body, static_cast<long long>(course->getId()));
+    body += ','; appendKey(body, "code"); appendString(body, course->getCode());
+    body += ','; appendKey(body, "name"); appendString(body, course->getName());
+    body += ','; appendKey(body, "instructor"); appendString(body, course->getInstructor());
+    body += ','; appendKey(body, "credits"); appendNumber(body, static_cast<long long>(course->getCredits()));
+    body += ','; appendKey(body, "capacity"); appendNumber(body, static_cast<long long>(course->getMaxCapacity()));
+    body += ','; appendKey(body, "enrolled"); appendNumber(body, static_cast<long long>(course->getCurrentEnrollment()));
+    body += ','; appendKey(body, "students"); body += '[';
+    std::vector<Student> roster = store.getRoster(code);
+    for (std::size_t i = 0; i < roster.size(); i++) {
+        if (i > 0) body += ',';
+        body += '{';
+        appendKey(body, "rollNo"); appendNumber(body, static_cast<long long>(roster[i].getRollNo()));
+        body += ','; appendKey(body, "name"); appendString(body, roster[i].getName());
+        body += '}';
+    }
+    body += "]}";
+    return json(200, std::move(body));
+}
+
+static HttpResponse changeEnrollment(ConcurrentStudentManagement& store, const HttpRequest& request) {
+    int rollNo;
+    auto code = request.params.find("code");
+    if (!intParam(request, "roll", rollNo) || code == request.params.end() || code->second.empty()) {
+        return error(400, "roll and code are required");
+    }
+
+    std::string message;
+    bool enrolling = request.method == "POST";
+    bool changed = enrolling ? store.enroll(rollNo, code->second, message)
+                             : store.drop(rollNo, code->second, message);
+    if (!changed) {
+        bool missing = message.find("not found") != std::string::npos || message.find("Unknown") == 0;
+        return error(missing ? 404 : 409, message);
+    }
+
+    std::string body = "{";
+    appendKey(body, "rollNo"); appendNumber(body, static_cast<long long>(rollNo));
+    body += ','; appendKey(body, "code"); appendString(body, code->second);
+    body += ','; appendKey(body, "enrolled"); body += enrolling ? "true" : "false";
+    body += '}';
+    return json(enrolling ? 201 : 200, std::move(body));
+}
+
+static HttpResponse getHistogram(ConcurrentStudentManagement& store) {
+    static const char* gradeLetters[] = {"A", "B", "C", "D", "E", "F"};
+    static const char* attendanceStatuses[] = {"Excellent", "Good", "Satisfactory", "Low"};
+    Kernels::RosterHistogram histogram = store.getRosterHistogram();
+
+    std::string body = "{";
+    appendKey(body, "grades");
+    body += '{';
+    for (int i = 0; i < 6; i++) {
+        if (i > 0) body += ',';
+        appendKey(body, gradeLetters[i]);
+        appendNumber(body, static_cast<long long>(histogram.grade[i]));
+    }
+    body += "},";
+    appendKey(body, "attendance");
+    body += '{';
+    for (int i = 0; i < 4; i++) {
+        if (i > 0) body += ',';
+        appendKey(body, attendanceStatuses[i]);
+        appendNumber(body, static_cast<long long>(histogram.attendance[i]));
+    }
+    body += "}}";
+    return json(200, std::move(body));
+}
+
+HttpResponse StudentApi::handle(ConcurrentStudentManagement& store, const HttpRequest& request) {
+    const std::string& path = request.path;
+    bool isGet = request.method == "GET";
+
+    if (path.rfind("/students/", 0) == 0) {
+        return isGet ? getStudent(store, path.substr(10)) : error(405, "use GET");
+    }
+    if (path.rfind("/courses/", 0) == 0) {
+        return isGet ? getCourse(store, path.substr(9)) : error(405, "use GET");
+    }
+    if (path == "/enrollments") {
+        if (request.method != "POST" && request.method != "DELETE") {
+            return error(405, "use POST to enroll or DELETE to drop");
+        }
+        return changeEnrollment(store, request);
+    }
+
+    if (path.rfind("/reports/", 0) == 0 && !isGet) {
+        return error(405, "use GET");
+    }
+    if (path == "/reports/top") {
+        int count = 5;
+        if (request.params.count("count") && (!intParam(request, "count", count) || count < 1 || count > 100)) {
+            return error(400, "count must be between 1 and 100");
+        }
+        return studentList(store.findTopPerformers(count));
+    }
+    if (path == "/reports/grades") {
+        float minGrade = 0;
+        float maxGrade = 100;
+        if ((request.params.count("min") && !floatParam(request, "min", minGrade)) ||
+            (request.params.count("max") && !floatParam(request, "max", maxGrade)) || minGrade > maxGrade) {
+            return error(400, "min and max must be grades with min <= max");
+        }
+        return studentList(store.findStudentsByGradeRange(minGrade, maxGrade));
+    }
+    if (path == "/reports/attendance") {
+        float minAttendance = 0;
+        if (request.params.count("min") && !floatParam(request, "min", minAttendance)) {
+            return error(400, "min must be a percentage");
+        }
+        return studentList(store.findStudentsByAttendance(minAttendance));
+    }
+    if (path == "/reports/histogram") {
+        return getHistogram(store);
+    }
+
+    return error(404, "no such endpoint " + path);
+}
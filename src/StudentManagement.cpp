@@ -1,11 +1,16 @@
 #include "../include/StudentManagement.h"
 #include "../include/Utils.h"
+#include "../include/Snapshot.h"
+#include "../include/CsvWriter.h"
+#include "../include/CsvReader.h"
 #include <fstream>
 #include <iostream>
 #include <iomanip>
+#include <memory_resource>
 #include <algorithm>
-#include <sstream>
 #include <filesystem>
+#include <stdexcept>
+#include <sstream>
 
 // Using the filesystem library for more robust file operations
 namespace fs = std::filesystem;
@@ -19,231 +24,693 @@ StudentManagement::StudentManagement() {
         fs::create_directory("data");
     }
 
-    loadStudentsFromFile();
-    loadCoursesFromFile();
-    loadEnrollmentsFromFile();
+    loadAllFiles();
+    replayJournal();
+}
+
+StudentManagement::~StudentManagement() {
+    if (arena) {
+        arena->drop();
+    }
+}
+
+const SlotMap<Student>& StudentManagement::getStudents() const { return students; }
+const SlotMap<Course>& StudentManagement::getCourses() const { return courses; }
+
+// The indexes hold handles, which stay valid when the stores reorder records,
+// so they only need a full rebuild after a load
+void StudentManagement::rebuildStudentIndex() {
+    rollIndex.clear();
+    rollIndex.reserve(students.size());
+    for (std::size_t i = 0; i < students.size(); i++) {
+        rollIndex.insert(students[i].getRollNo(), students.handleAt(i));
+    }
+}
+
+void StudentManagement::rebuildCourseIndex() {
+    codeIndex.clear();
+    codeIndex.reserve(courses.size());
+    for (std::size_t i = 0; i < courses.size(); i++) {
+        codeIndex.insert(std::string(courses[i].getCode()), courses.handleAt(i));
+    }
+}
+
+StudentHandle StudentManagement::findStudentHandle(int rollNo) const {
+    const StudentHandle* handle = rollIndex.find(rollNo);
+    return handle ? *handle : StudentHandle{};
+}
+
+CourseHandle StudentManagement::findCourseHandle(const std::string& code) const {
+    const CourseHandle* handle = codeIndex.find(code);
+    return handle ? *handle : CourseHandle{};
 }
 
 // I added these helper methods to handle common tasks that are used throughout the system
 // This method ensures we don't have duplicate roll numbers - something I found important for data integrity
 bool StudentManagement::isRollNoUnique(int rollNo) const {
-    for (const auto& student : students) {
-        if (student.getRollNo() == rollNo) {
-            return false;
-        }
-    }
-    return true;
+    return !rollIndex.contains(rollNo);
 }
 
 bool StudentManagement::isCourseCodeUnique(const std::string& code) const {
-    for (const auto& course : courses) {
-        if (course.getCode() == code) {
-            return false;
-        }
-    }
-    return true;
+    return !codeIndex.contains(code);
 }
 
+// Ids are the highest one in use plus one, so deleting the newest record frees its id again
+// The maximum is cached; adding thousands of records in a batch would rescan every time otherwise
 int StudentManagement::generateStudentId() const {
-    int maxId = 0;
-    for (const auto& student : students) {
-        if (student.getId() > maxId) {
-            maxId = student.getId();
+    if (studentIdsStale) {
+        maxStudentId = 0;
+        for (const auto& student : students) {
+            maxStudentId = std::max(maxStudentId, student.getId());
         }
+        studentIdsStale = false;
     }
-    return maxId + 1;
+    return maxStudentId + 1;
 }
 
 int StudentManagement::generateCourseId() const {
-    int maxId = 0;
-    for (const auto& course : courses) {
-        if (course.getId() > maxId) {
-            maxId = course.getId();
+    if (courseIdsStale) {
+        maxCourseId = 0;
+        for (const auto& course : courses) {
+            maxCourseId = std::max(maxCourseId, course.getId());
         }
+        courseIdsStale = false;
     }
-    return maxId + 1;
+    return maxCourseId + 1;
 }
 
-// My file operation methods - I designed these to keep data persistent between program runs
-// I chose CSV format for easier integration with other tools if needed
-void StudentManagement::saveStudentsToFile() const {
-    std::ofstream outFile(studentFile);
-    if (!outFile) {
-        UI::printError("Error opening student file for writing!");
+void StudentManagement::eraseStudent(StudentHandle handle) {
+    const Student* student = students.get(handle);
+    if (!student) {
         return;
     }
     
-    // I'm adding a header row to make the CSV more readable and self-documenting
-    outFile << "id,name,rollNo,grade,attendance,email,phone,address" << std::endl;
+    // Only the courses on the student's own list can hold a seat for them
+    for (CourseHandle courseHandle : student->getEnrolledCourses()) {
+        if (Course* course = courses.get(courseHandle)) {
+            course->removeStudent(handle);
+        }
+    }
     
-    // Write student data
-    for (const auto& student : students) {
-        outFile << student.toCSV() << std::endl;
+    rollIndex.erase(student->getRollNo());
+    if (student->getId() >= maxStudentId) {
+        studentIdsStale = true;
     }
-    outFile.close();
+    analytics.swapRemove(students.indexOf(handle));
+    unindexStudent(handle);
+    students.erase(handle);
 }
 
-void StudentManagement::saveCoursesToFile() const {
-    std::ofstream outFile(courseFile);
-    if (!outFile) {
-        UI::printError("Error opening course file for writing!");
+void StudentManagement::eraseCourse(CourseHandle handle) {
+    const Course* course = courses.get(handle);
+    if (!course) {
         return;
     }
     
-    // Write header
-    outFile << "id,code,name,instructor,credits,maxCapacity" << std::endl;
+    // Seated students are reached through the course's own list; unseated links
+    // are not listed anywhere, so only then is every student checked
+    if (unseatedLinks == 0) {
+        for (StudentHandle studentHandle : course->getEnrolledStudents()) {
+            if (Student* student = students.get(studentHandle)) {
+                student->dropCourse(handle);
+            }
+        }
+    } else {
+        for (auto& student : students) {
+            student.dropCourse(handle);
+        }
+    }
     
-    // Write course data
-    for (const auto& course : courses) {
-        outFile << course.toCSV() << std::endl;
+    codeIndex.erase(std::string(course->getCode()));
+    if (course->getId() >= maxCourseId) {
+        courseIdsStale = true;
+    }
+    courses.erase(handle);
+}
+
+// Journal records carry full rows, so replaying a record twice gives the same state
+// This keeps recovery correct even if we crash between writing the snapshot and truncating the journal
+static std::vector<std::string> studentFields(const Student& s) {
+    return {std::to_string(s.getId()), std::string(s.getName()), std::to_string(s.getRollNo()),
+            std::to_string(s.getGrade()), std::to_string(s.getAttendance()),
+            std::string(s.getEmail()), std::string(s.getPhone()), std::string(s.getAddress())};
+}
+
+static std::vector<std::string> courseFields(const Course& c) {
+    return {std::to_string(c.getId()), std::string(c.getCode()), std::string(c.getName()), std::string(c.getInstructor()),
+            std::to_string(c.getCredits()), std::to_string(c.getMaxCapacity())};
+}
+
+// Which data files a journal record makes stale; deletes cascade into the enrollments
+static unsigned tablesChangedBy(JournalOp op) {
+    switch (op) {
+        case JournalOp::AddStudent:
+        case JournalOp::UpdateStudent:
+            return StudentTable;
+        case JournalOp::DeleteStudent:
+            return StudentTable | EnrollmentTable;
+        case JournalOp::AddCourse:
+        case JournalOp::UpdateCourse:
+            return CourseTable;
+        case JournalOp::DeleteCourse:
+            return CourseTable | EnrollmentTable;
+        case JournalOp::Enroll:
+        case JournalOp::Drop:
+            return EnrollmentTable;
     }
-    outFile.close();
+    return AllTables;
 }
 
-void StudentManagement::saveEnrollmentsToFile() const {
-    std::ofstream outFile(enrollmentFile);
-    if (!outFile) {
-        UI::printError("Error opening enrollment file for writing!");
+// The journal record is written before this returns, on the caller's thread: it is one
+// short write, and the operating system has it before the menu or a client hears back
+// (fsynced too under the immediate policy). The data files follow the flush policy
+void StudentManagement::logMutation(JournalOp op, const std::vector<std::string>& fields) {
+    if (bulkUpdate) {
+        persistence.markDirty(tablesChangedBy(op));
         return;
     }
-    
-    // Write header
-    outFile << "studentId,courseId" << std::endl;
-    
-    // Write enrollment data
-    for (const auto& student : students) {
-        for (const auto& course : student.getEnrolledCourses()) {
-            outFile << student.getId() << "," << course->getId() << std::endl;
+    bool journaled;
+    {
+        std::lock_guard<std::mutex> lock(logMutex);
+        journaled = journal.append(op, fields);
+        persistence.recordChange(tablesChangedBy(op));
+        if (!journaled) {
+            persistence.markDirty(tablesChangedBy(op));
         }
     }
-    outFile.close();
+    if (!journaled) {
+        UI::printError("Could not write the journal. This change is only saved with the next flush of the data files.");
+    }
+    if (inlineFlushes) {
+        flushIfDue();
+    }
+}
+
+// Used with inline flushes turned off, where the caller flushes under its own lock
+bool StudentManagement::isFlushDue() const {
+    std::lock_guard<std::mutex> lock(logMutex);
+    return persistence.isFlushDue();
+}
+
+void StudentManagement::setInlineFlushes(bool enabled) {
+    inlineFlushes = enabled;
+}
+
+void StudentManagement::flushIfDue() {
+    // A failed background save left the journal in place; rewrite everything next time
+    if (writer.takeFailure()) {
+        UI::printError("A background save failed. The journal was kept and the data files will be written again.");
+        persistence.markDirty(AllTables);
+    }
+    if (persistence.isFlushDue()) {
+        flushDataFiles();
+    }
 }
 
-void StudentManagement::loadStudentsFromFile() {
-    std::ifstream inFile(studentFile);
-    if (!inFile) {
-        UI::printInfo("No existing student data file found. Starting fresh.");
+// The dirty tables and the snapshot are rendered to memory here, which is quick,
+// and the writer thread puts them on disk and then drops the journal records they hold.
+// Records appended after the rendering are kept for the next flush
+void StudentManagement::flushDataFiles() {
+    if (!persistence.hasDirtyTables()) {
         return;
     }
     
-    students.clear();
-    std::string line;
-    
-    // Skip header
-    std::getline(inFile, line);
-    
-    while (std::getline(inFile, line)) {
-        std::stringstream ss(line);
-        std::string token;
-        std::vector<std::string> tokens;
-        
-        while (std::getline(ss, token, ',')) {
-            tokens.push_back(token);
+    struct PendingFile {
+        std::string path;
+        std::string contents;
+    };
+    std::vector<PendingFile> files;
+    auto render = [&files](const std::string& path, auto save) {
+        std::ostringstream out;
+        save(out);
+        files.push_back({path, out.str()});
+    };
+    if (persistence.isDirty(StudentTable)) {
+        render(studentFile, [this](std::ostream& out) { saveStudentsToFile(out); });
+    }
+    if (persistence.isDirty(CourseTable)) {
+        render(courseFile, [this](std::ostream& out) { saveCoursesToFile(out); });
+    }
+    if (persistence.isDirty(EnrollmentTable)) {
+        render(enrollmentFile, [this](std::ostream& out) { saveEnrollmentsToFile(out); });
+    }
+    std::string snapshot;
+    bool haveSnapshot = Snapshot::encode(students, courses, snapshot);
+    std::uint64_t journalCovered = journal.position();
+    
+    writer.submit([this, files = std::move(files), snapshot = std::move(snapshot), haveSnapshot, journalCovered]() {
+        for (const auto& file : files) {
+            bool written = PersistenceManager::writeAtomically(file.path, [&file](std::ostream& out) {
+                out.write(file.contents.data(), file.contents.size());
+            });
+            if (!written) {
+                return false;
+            }
         }
-        
-        if (tokens.size() >= 8) {
-            int id = std::stoi(tokens[0]);
-            std::string name = tokens[1];
-            int rollNo = std::stoi(tokens[2]);
-            float grade = std::stof(tokens[3]);
-            float attendance = std::stof(tokens[4]);
-            std::string email = tokens[5];
-            std::string phone = tokens[6];
-            std::string address = tokens[7];
-            
-            students.emplace_back(id, name, rollNo, grade, attendance, email, phone, address);
+        // The snapshot is only a startup shortcut, a failure here is not worth keeping the journal for
+        if (haveSnapshot) {
+            PersistenceManager::writeAtomically(snapshotFile, [&snapshot](std::ostream& out) {
+                out.write(snapshot.data(), snapshot.size());
+            });
         }
+        // Every data file and its rename are fsynced by now, so these records are no longer needed
+        return journal.discardBefore(journalCovered);
+    });
+    persistence.markFlushed();
+}
+
+void StudentManagement::waitForPendingWrites() {
+    writer.waitForPending();
+}
+
+bool StudentManagement::flushAndWait() {
+    flushDataFiles();
+    writer.waitForPending();
+    return !writer.takeFailure();
+}
+
+WriterMetrics StudentManagement::getWriterMetrics() const {
+    return writer.metrics();
+}
+
+void StudentManagement::compactDataFiles() {
+    persistence.markDirty(AllTables);
+    flushDataFiles();
+}
+
+void StudentManagement::setFlushPolicy(const FlushPolicy& policy) {
+    persistence.setPolicy(policy);
+    // Immediate promises every change is on disk once it's made, so each journal record is fsynced before logMutation returns
+    journal.setSyncEveryAppend(policy.mode == FlushPolicy::Immediate);
+    flushIfDue();
+}
+
+void StudentManagement::beginBulkUpdate() {
+    bulkUpdate = true;
+    indexesBeforeBulk = secondaryIndexesEnabled;
+    secondaryIndexesEnabled = false;
+}
+
+bool StudentManagement::endBulkUpdate() {
+    bulkUpdate = false;
+    setSecondaryIndexesEnabled(indexesBeforeBulk);
+    return flushAndWait();
+}
+
+bool StudentManagement::exportSnapshot(const std::string& path) const {
+    return Snapshot::write(path, students, courses);
+}
+
+// Replaces everything in memory with the snapshot and rewrites the CSV files from it
+bool StudentManagement::importSnapshot(const std::string& path) {
+    ParsedTables tables;
+    if (!Snapshot::read(path, tables)) {
+        return false;
     }
     
-    inFile.close();
+    ThreadPool pool;
+    installTables(tables, pool);
+    compactDataFiles();
+    return true;
 }
 
-void StudentManagement::loadCoursesFromFile() {
-    std::ifstream inFile(courseFile);
-    if (!inFile) {
-        UI::printInfo("No existing course data file found. Starting fresh.");
+void StudentManagement::replayJournal() {
+    std::vector<JournalRecord> records = journal.readAll();
+    if (records.empty()) {
         return;
     }
     
-    courses.clear();
-    std::string line;
+    std::unordered_map<int, StudentHandle> studentIds;
+    std::unordered_map<int, CourseHandle> courseIds;
+    for (std::size_t i = 0; i < students.size(); i++) {
+        studentIds[students[i].getId()] = students.handleAt(i);
+    }
+    for (std::size_t i = 0; i < courses.size(); i++) {
+        courseIds[courses[i].getId()] = courses.handleAt(i);
+    }
     
-    // Skip header
-    std::getline(inFile, line);
+    std::size_t skipped = 0;
+    for (const auto& record : records) {
+        try {
+            applyJournalRecord(record, studentIds, courseIds);
+            persistence.recordChange(tablesChangedBy(record.op));
+        } catch (const std::exception&) {
+            skipped++;
+        }
+    }
     
-    while (std::getline(inFile, line)) {
-        std::stringstream ss(line);
-        std::string token;
-        std::vector<std::string> tokens;
-        
-        while (std::getline(ss, token, ',')) {
-            tokens.push_back(token);
+    UI::printInfo("Replayed " + std::to_string(records.size() - skipped) + " journal records.");
+    if (skipped > 0) {
+        UI::printWarning("Skipped " + std::to_string(skipped) + " malformed journal records.");
+    }
+}
+
+// Numbers in a journal record must be whole fields; anything else means the record is damaged
+static int journalInt(const std::string& field) {
+    int value;
+    if (!Csv::parseInt(field, value)) {
+        throw std::invalid_argument("journal number");
+    }
+    return value;
+}
+
+static float journalFloat(const std::string& field) {
+    float value;
+    if (!Csv::parseFloat(field, value)) {
+        throw std::invalid_argument("journal number");
+    }
+    return value;
+}
+
+void StudentManagement::applyJournalRecord(const JournalRecord& record,
+                                           std::unordered_map<int, StudentHandle>& studentIds,
+                                           std::unordered_map<int, CourseHandle>& courseIds) {
+    const auto& f = record.fields;
+    switch (record.op) {
+        case JournalOp::AddStudent:
+        case JournalOp::UpdateStudent: {
+            if (f.size() < 8) throw std::invalid_argument("student record");
+            int id = journalInt(f[0]);
+            int rollNo = journalInt(f[2]);
+            Student* student = nullptr;
+            if (studentIds.count(id)) {
+                student = students.get(studentIds[id]);
+            }
+            if (student) {
+                rollIndex.erase(student->getRollNo());
+                student->setName(f[1]);
+                student->setRollNo(rollNo);
+                student->setGrade(journalFloat(f[3]));
+                student->setAttendance(journalFloat(f[4]));
+                student->setEmail(f[5]);
+                student->setPhone(f[6]);
+                student->setAddress(f[7]);
+                rollIndex.insert(rollNo, studentIds[id]);
+                analytics.update(students.indexOf(studentIds[id]), *student);
+                indexStudent(studentIds[id]);
+            } else {
+                StudentHandle handle = students.emplace(id, f[1], rollNo, journalFloat(f[3]), journalFloat(f[4]), f[5], f[6], f[7]);
+                maxStudentId = std::max(maxStudentId, id);
+                studentIds[id] = handle;
+                rollIndex.insert(rollNo, handle);
+                analytics.append(*students.get(handle));
+                indexStudent(handle);
+            }
+            break;
         }
-        
-        if (tokens.size() >= 6) {
-            int id = std::stoi(tokens[0]);
-            std::string code = tokens[1];
-            std::string name = tokens[2];
-            std::string instructor = tokens[3];
-            int credits = std::stoi(tokens[4]);
-            int maxCapacity = std::stoi(tokens[5]);
-            
-            courses.emplace_back(id, code, name, instructor, credits, maxCapacity);
+        case JournalOp::DeleteStudent: {
+            if (f.empty()) throw std::invalid_argument("student record");
+            int id = journalInt(f[0]);
+            if (studentIds.count(id)) {
+                eraseStudent(studentIds[id]);
+                studentIds.erase(id);
+            }
+            break;
         }
+        case JournalOp::AddCourse:
+        case JournalOp::UpdateCourse: {
+            if (f.size() < 6) throw std::invalid_argument("course record");
+            int id = journalInt(f[0]);
+            Course* course = nullptr;
+            if (courseIds.count(id)) {
+                course = courses.get(courseIds[id]);
+            }
+            if (course) {
+                codeIndex.erase(std::string(course->getCode()));
+                course->setCode(f[1]);
+                course->setName(f[2]);
+                course->setInstructor(f[3]);
+                course->setCredits(journalInt(f[4]));
+                course->setMaxCapacity(journalInt(f[5]));
+                codeIndex.insert(f[1], courseIds[id]);
+            } else {
+                CourseHandle handle = courses.emplace(id, f[1], f[2], f[3], journalInt(f[4]), journalInt(f[5]));
+                maxCourseId = std::max(maxCourseId, id);
+                courseIds[id] = handle;
+                codeIndex.insert(f[1], handle);
+            }
+            break;
+        }
+        case JournalOp::DeleteCourse: {
+            if (f.empty()) throw std::invalid_argument("course record");
+            int id = journalInt(f[0]);
+            if (courseIds.count(id)) {
+                eraseCourse(courseIds[id]);
+                courseIds.erase(id);
+            }
+            break;
+        }
+        case JournalOp::Enroll:
+        case JournalOp::Drop: {
+            if (f.size() < 2) throw std::invalid_argument("enrollment record");
+            int studentId = journalInt(f[0]);
+            int courseId = journalInt(f[1]);
+            if (!studentIds.count(studentId) || !courseIds.count(courseId)) {
+                break;
+            }
+            StudentHandle studentHandle = studentIds[studentId];
+            CourseHandle courseHandle = courseIds[courseId];
+            Student* student = students.get(studentHandle);
+            Course* course = courses.get(courseHandle);
+            if (!student || !course) {
+                break;
+            }
+            if (record.op == JournalOp::Enroll) {
+                linkEnrollment(studentHandle, courseHandle);
+            } else {
+                student->dropCourse(courseHandle);
+                course->removeStudent(studentHandle);
+            }
+            break;
+        }
+        default:
+            throw std::invalid_argument("unknown journal op");
     }
+}
+
+// My file operation methods - I designed these to keep data persistent between program runs
+// I chose CSV format for easier integration with other tools if needed
+void StudentManagement::saveStudentsToFile(std::ostream& outFile) const {
+    CsvWriter writer(outFile);
     
-    inFile.close();
+    // I'm adding a header row to make the CSV more readable and self-documenting
+    writer.line("id,name,rollNo,grade,attendance,email,phone,address");
+    
+    // Write student data
+    for (const auto& student : students) {
+        student.writeCSV(writer);
+    }
 }
 
-void StudentManagement::loadEnrollmentsFromFile() {
-    std::ifstream inFile(enrollmentFile);
-    if (!inFile) {
-        UI::printInfo("No existing enrollment data file found. Starting fresh.");
-        return;
+void StudentManagement::saveCoursesToFile(std::ostream& outFile) const {
+    CsvWriter writer(outFile);
+    
+    // Write header
+    writer.line("id,code,name,instructor,credits,maxCapacity");
+    
+    // Write course data
+    for (const auto& course : courses) {
+        course.writeCSV(writer);
     }
+}
+
+void StudentManagement::saveEnrollmentsToFile(std::ostream& outFile) const {
+    CsvWriter writer(outFile);
     
-    std::string line;
+    // Write header
+    writer.line("studentId,courseId");
     
-    // Skip header
-    std::getline(inFile, line);
+    // Write enrollment data
+    for (const auto& student : students) {
+        for (const auto& handle : student.getEnrolledCourses()) {
+            const Course* course = courses.get(handle);
+            if (course) {
+                writer.field(student.getId());
+                writer.field(course->getId());
+                writer.endRow();
+            }
+        }
+    }
+}
+
+// Startup prefers the binary snapshot when it is at least as new as the CSV files,
+// so CSV files edited by other tools still win. Otherwise all three CSV files are
+// parsed on a thread pool at the same time (see DataLoader)
+void StudentManagement::loadAllFiles() {
+    ThreadPool pool;
+    ParsedTables tables;
+    
+    if (!isSnapshotFresh() || !Snapshot::read(snapshotFile, tables)) {
+        tables = DataLoader::parseAll(studentFile, courseFile, enrollmentFile, pool);
+        
+        if (!tables.studentsFound) {
+            UI::printInfo("No existing student data file found. Starting fresh.");
+        }
+        if (!tables.coursesFound) {
+            UI::printInfo("No existing course data file found. Starting fresh.");
+        }
+        if (!tables.enrollmentsFound) {
+            UI::printInfo("No existing enrollment data file found. Starting fresh.");
+        }
+    }
+    
+    installTables(tables, pool);
+}
+
+bool StudentManagement::isSnapshotFresh() const {
+    std::error_code error;
+    auto snapshotTime = fs::last_write_time(snapshotFile, error);
+    if (error) {
+        return false;
+    }
     
-    // Create maps for fast lookup
-    std::map<int, Student*> studentMap;
-    std::map<int, Course*> courseMap;
+    for (const auto& file : {studentFile, courseFile, enrollmentFile}) {
+        auto csvTime = fs::last_write_time(file, error);
+        if (!error && csvTime > snapshotTime) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Moves parsed rows into the stores in file order and joins the enrollments
+void StudentManagement::installTables(ParsedTables& tables, ThreadPool& pool) {
+    // The old records go first without freeing anything, then their arena is dropped in one go
+    if (arena) {
+        arena->drop();
+    }
+    students.clear();
+    courses.clear();
+    arena = std::move(tables.arena);
     
-    for (auto& student : students) {
-        studentMap[student.getId()] = &student;
+    std::size_t studentCount = 0;
+    for (const auto& chunk : tables.studentChunks) {
+        studentCount += chunk.size();
+    }
+    students.reserve(studentCount);
+    for (auto& chunk : tables.studentChunks) {
+        for (auto& student : chunk) {
+            students.emplace(std::move(student));
+        }
     }
     
-    for (auto& course : courses) {
-        courseMap[course.getId()] = &course;
+    std::size_t courseCount = 0;
+    for (const auto& chunk : tables.courseChunks) {
+        courseCount += chunk.size();
+    }
+    courses.reserve(courseCount);
+    unseatedLinks = 0;
+    studentIdsStale = true;
+    courseIdsStale = true;
+    for (auto& chunk : tables.courseChunks) {
+        for (auto& course : chunk) {
+            courses.emplace(std::move(course));
+        }
     }
     
-    // Load enrollments
-    while (std::getline(inFile, line)) {
-        std::stringstream ss(line);
-        std::string token;
-        std::vector<std::string> tokens;
-        
-        while (std::getline(ss, token, ',')) {
-            tokens.push_back(token);
+    rebuildStudentIndex();
+    rebuildCourseIndex();
+    analytics.rebuild(students);
+    rebuildSecondaryIndexes();
+    linkEnrollments(tables.enrollmentChunks, pool);
+}
+
+// A parallel hash join of the enrollment pairs against the student and course ids
+// Linking is partitioned by slot so every task owns the records it modifies
+void StudentManagement::linkEnrollments(const std::vector<std::vector<std::pair<int, int>>>& chunks, ThreadPool& pool) {
+    // Build side: id -> handle tables for both stores, built at the same time
+    // Their nodes live in one arena each and go away together at the end
+    std::pmr::monotonic_buffer_resource studentIdNodes, courseIdNodes;
+    std::pmr::unordered_map<int, StudentHandle> studentIds(&studentIdNodes);
+    std::pmr::unordered_map<int, CourseHandle> courseIds(&courseIdNodes);
+    auto buildStudents = pool.submit([this, &studentIds]() {
+        studentIds.reserve(students.size());
+        for (std::size_t i = 0; i < students.size(); i++) {
+            studentIds[students[i].getId()] = students.handleAt(i);
         }
-        
-        if (tokens.size() >= 2) {
-            int studentId = std::stoi(tokens[0]);
-            int courseId = std::stoi(tokens[1]);
-            
-            if (studentMap.count(studentId) && courseMap.count(courseId)) {
-                Student* student = studentMap[studentId];
-                Course* course = courseMap[courseId];
-                
-                student->enrollCourse(course);
-                course->addStudent(student);
+    });
+    auto buildCourses = pool.submit([this, &courseIds]() {
+        courseIds.reserve(courses.size());
+        for (std::size_t i = 0; i < courses.size(); i++) {
+            courseIds[courses[i].getId()] = courses.handleAt(i);
+        }
+    });
+    buildStudents.get();
+    buildCourses.get();
+    
+    // Probe side: every chunk resolves its ids on its own task
+    std::vector<std::vector<std::pair<StudentHandle, CourseHandle>>> resolved(chunks.size());
+    std::vector<std::future<void>> pending;
+    for (std::size_t c = 0; c < chunks.size(); c++) {
+        pending.push_back(pool.submit([&, c]() {
+            resolved[c].reserve(chunks[c].size());
+            for (const auto& pair : chunks[c]) {
+                auto student = studentIds.find(pair.first);
+                auto course = courseIds.find(pair.second);
+                if (student != studentIds.end() && course != courseIds.end()) {
+                    resolved[c].emplace_back(student->second, course->second);
+                }
             }
+        }));
+    }
+    for (auto& task : pending) {
+        task.get();
+    }
+    
+    // Every enrollment set is sized once up front, so the bulk build never rehashes
+    std::vector<std::uint32_t> seatCounts(courses.size(), 0);
+    std::vector<std::uint32_t> courseCounts(students.size(), 0);
+    for (const auto& links : resolved) {
+        for (const auto& link : links) {
+            seatCounts[courses.indexOf(link.second)]++;
+            courseCounts[students.indexOf(link.first)]++;
         }
     }
+    for (std::size_t i = 0; i < courses.size(); i++) {
+        courses[i].reserveSeats(std::min<std::size_t>(seatCounts[i], std::max(0, courses[i].getMaxCapacity())));
+    }
+    for (std::size_t i = 0; i < students.size(); i++) {
+        students[i].reserveCourses(courseCounts[i]);
+    }
     
-    inFile.close();
+    // Like the old loader, the student side keeps every pair while a full course refuses
+    // the overflow; both sides link in the same pass since each task owns its slots
+    std::size_t parts = pool.size();
+    std::vector<std::size_t> refused(parts, 0);
+    pending.clear();
+    for (std::size_t p = 0; p < parts; p++) {
+        pending.push_back(pool.submit([&, p]() {
+            for (const auto& links : resolved) {
+                for (const auto& link : links) {
+                    if (link.first.index % parts == p) {
+                        students.get(link.first)->enrollCourse(link.second);
+                    }
+                    if (link.second.index % parts == p) {
+                        Course* course = courses.get(link.second);
+                        if (!course->addStudent(link.first) && !course->hasStudent(link.first)) {
+                            refused[p]++;
+                        }
+                    }
+                }
+            }
+        }));
+    }
+    for (auto& task : pending) {
+        task.get();
+    }
+    for (std::size_t count : refused) {
+        unseatedLinks += count;
+    }
+}
+
+// Links both sides of one enrollment; a full course refuses the seat but the
+// student side keeps the link, the same way the loader treats old data files
+void StudentManagement::linkEnrollment(StudentHandle student, CourseHandle course) {
+    students.get(student)->enrollCourse(course);
+    Course* target = courses.get(course);
+    if (!target->addStudent(student) && !target->hasStudent(student)) {
+        unseatedLinks++;
+    }
 }
 
 // Student management methods
@@ -271,54 +738,88 @@ void StudentManagement::addStudent() {
     std::string phone = Validation::getPhone("Enter phone (optional): ");
     std::string address = Validation::getString("Enter address (optional): ", true);
     
-    int id = generateStudentId();
-    
-    students.emplace_back(id, name, rollNo, grade, attendance, email, phone, address);
-    saveStudentsToFile();
+    std::string error;
+    if (!insertStudent(name, rollNo, grade, attendance, email, phone, address, error)) {
+        UI::printError(error);
+        return;
+    }
     
     UI::printSuccess("Student added successfully!");
 }
 
-void StudentManagement::displayAllStudents() const {
+bool StudentManagement::insertStudent(const std::string& name, int rollNo, float grade, float attendance,
+                                      const std::string& email, const std::string& phone,
+                                      const std::string& address, std::string& error) {
+    if (name.empty()) {
+        error = "Student name is empty";
+        return false;
+    }
+    if (rollNo < 1 || !isRollNoUnique(rollNo)) {
+        error = "Roll number " + std::to_string(rollNo) + " is invalid or already exists";
+        return false;
+    }
+    if (grade < 0 || grade > 100 || attendance < 0 || attendance > 100) {
+        error = "Grade and attendance must be between 0 and 100";
+        return false;
+    }
+    if (!email.empty() && !Validation::isValidEmail(email)) {
+        error = "Invalid email format: " + email;
+        return false;
+    }
+    if (!phone.empty() && !Validation::isValidPhone(phone)) {
+        error = "Invalid phone number format: " + phone;
+        return false;
+    }
+    
+    int id = generateStudentId();
+    maxStudentId = id;
+    
+    StudentHandle handle = students.emplace(id, name, rollNo, grade, attendance, email, phone, address);
+    rollIndex.insert(rollNo, handle);
+    analytics.append(*students.get(handle));
+    indexStudent(handle);
+    logMutation(JournalOp::AddStudent, studentFields(*students.get(handle)));
+    return true;
+}
+
+void StudentManagement::displayAllStudents(std::ostream& out) const {
     if (students.empty()) {
         UI::printInfo("No students found!");
         return;
     }
     
-    UI::printTitle("All Students");
-    
-    std::cout << "+----------------------+----------+-------+------------+" << std::endl;
-    std::cout << "| " << Color::cyan << "Name" << Color::reset 
-              << "                 | " << Color::cyan << "Roll No" << Color::reset 
-              << "  | " << Color::cyan << "Grade" << Color::reset 
-              << " | " << Color::cyan << "Attendance" << Color::reset << " |" << std::endl;
-    std::cout << "+----------------------+----------+-------+------------+" << std::endl;
+    ReportWriter report(out);
+    report.title("All Students");
+    printStudentTableHeader(report);
     
     for (const auto& student : students) {
-        student.display();
+        student.display(report);
     }
     
-    std::cout << "+----------------------+----------+-------+------------+" << std::endl;
-    std::cout << "| Total students: " << std::left << std::setw(22) << students.size() << " |" << std::endl;
-    std::cout << "+----------------------+----------+-------+------------+" << std::endl;
+    printStudentTableFooter(report, "Total students: ", students.size());
+}
+
+void StudentManagement::printStudentTableHeader(ReportWriter& out) const {
+    out.text("+----------------------+----------+-------+------------+").endLine();
+    out.text("| ").color(Color::cyan).text("Name").color(Color::reset)
+       .text("                 | ").color(Color::cyan).text("Roll No").color(Color::reset)
+       .text("  | ").color(Color::cyan).text("Grade").color(Color::reset)
+       .text(" | ").color(Color::cyan).text("Attendance").color(Color::reset).text(" |").endLine();
+    out.text("+----------------------+----------+-------+------------+").endLine();
+}
+
+void StudentManagement::printStudentTableFooter(ReportWriter& out, const std::string& label, std::size_t count) const {
+    out.text("+----------------------+----------+-------+------------+").endLine();
+    out.text("| ").text(label).cell(count, 38 - label.size()).text(" |").endLine();
+    out.text("+----------------------+----------+-------+------------+").endLine();
 }
 
 Student* StudentManagement::searchStudentByRoll(int rollNo) {
-    for (auto& student : students) {
-        if (student.getRollNo() == rollNo) {
-            return &student;
-        }
-    }
-    return nullptr;
+    return students.get(findStudentHandle(rollNo));
 }
 
 const Student* StudentManagement::searchStudentByRoll(int rollNo) const {
-    for (const auto& student : students) {
-        if (student.getRollNo() == rollNo) {
-            return &student;
-        }
-    }
-    return nullptr;
+    return students.get(findStudentHandle(rollNo));
 }
 
 void StudentManagement::updateStudent(int rollNo) {
@@ -329,12 +830,15 @@ void StudentManagement::updateStudent(int rollNo) {
         return;
     }
     
-    UI::printTitle("Update Student");
-    student->displayDetailed();
+    {
+        ReportWriter report(std::cout);
+        report.title("Update Student");
+        student->displayDetailed(courses, report);
+    }
     
     std::cout << "\nEnter new details (leave empty to keep current):\n";
     
-    std::string name = Validation::getString("Enter new name [" + student->getName() + "]: ", true);
+    std::string name = Validation::getString("Enter new name [" + std::string(student->getName()) + "]: ", true);
     if (!name.empty()) {
         student->setName(name);
     }
@@ -351,50 +855,78 @@ void StudentManagement::updateStudent(int rollNo) {
         student->setAttendance(attendance);
     }
     
-    std::string email = Validation::getString("Enter new email [" + student->getEmail() + "]: ", true);
+    std::string email = Validation::getString("Enter new email [" + std::string(student->getEmail()) + "]: ", true);
     if (!email.empty()) {
         student->setEmail(email);
     }
     
-    std::string phone = Validation::getString("Enter new phone [" + student->getPhone() + "]: ", true);
+    std::string phone = Validation::getString("Enter new phone [" + std::string(student->getPhone()) + "]: ", true);
     if (!phone.empty()) {
         student->setPhone(phone);
     }
     
-    std::string address = Validation::getString("Enter new address [" + student->getAddress() + "]: ", true);
+    std::string address = Validation::getString("Enter new address [" + std::string(student->getAddress()) + "]: ", true);
     if (!address.empty()) {
         student->setAddress(address);
     }
     
-    saveStudentsToFile();
+    StudentHandle handle = findStudentHandle(rollNo);
+    analytics.update(students.indexOf(handle), *student);
+    indexStudent(handle);
+    logMutation(JournalOp::UpdateStudent, studentFields(*student));
     UI::printSuccess("Student updated successfully!");
 }
 
+bool StudentManagement::setGrade(int rollNo, float grade, std::string& error) {
+    StudentHandle handle = findStudentHandle(rollNo);
+    Student* student = students.get(handle);
+    if (!student) {
+        error = "Student with roll number " + std::to_string(rollNo) + " not found!";
+        return false;
+    }
+    if (grade < 0 || grade > 100) {
+        error = "Grade must be between 0 and 100";
+        return false;
+    }
+    
+    student->setGrade(grade);
+    analytics.update(students.indexOf(handle), *student);
+    indexStudent(handle);
+    logMutation(JournalOp::UpdateStudent, studentFields(*student));
+    return true;
+}
+
 void StudentManagement::deleteStudent(int rollNo) {
-    auto it = std::find_if(students.begin(), students.end(), [rollNo](const Student& s) {
-        return s.getRollNo() == rollNo;
-    });
+    const Student* student = searchStudentByRoll(rollNo);
     
-    if (it != students.end()) {
-        // Remove student from all courses
-        for (auto& course : courses) {
-            for (auto* enrolledStudent : course.getEnrolledStudents()) {
-                if (enrolledStudent->getRollNo() == rollNo) {
-                    course.removeStudent(enrolledStudent);
-                    break;
-                }
-            }
-        }
-        
-        students.erase(it);
-        saveStudentsToFile();
-        saveEnrollmentsToFile();
+    if (student) {
+        int id = student->getId();
+        eraseStudent(findStudentHandle(rollNo));
+        logMutation(JournalOp::DeleteStudent, {std::to_string(id)});
         UI::printSuccess("Student with roll number " + std::to_string(rollNo) + " deleted successfully!");
     } else {
         UI::printError("Student with roll number " + std::to_string(rollNo) + " not found!");
     }
 }
 
+// Batch delete for end-of-term purges; every delete only touches the student's own
+// courses, so the cost follows the number of enrollments removed, not the store size
+std::size_t StudentManagement::deleteStudents(const std::vector<int>& rollNos) {
+    std::size_t deleted = 0;
+    for (int rollNo : rollNos) {
+        StudentHandle handle = findStudentHandle(rollNo);
+        const Student* student = students.get(handle);
+        if (!student) {
+            continue;
+        }
+        int id = student->getId();
+        eraseStudent(handle);
+        logMutation(JournalOp::DeleteStudent, {std::to_string(id)});
+        deleted++;
+    }
+    return deleted;
+}
+
 // Course management methods
 void StudentManagement::addCourse() {
     UI::printTitle("Add New Course");
@@ -416,55 +948,72 @@ void StudentManagement::addCourse() {
     int credits = Validation::getInteger("Enter number of credits: ", 1, 10);
     int maxCapacity = Validation::getInteger("Enter maximum capacity: ", 1, 200);
     
-    int id = generateCourseId();
-    
-    courses.emplace_back(id, code, name, instructor, credits, maxCapacity);
-    saveCoursesToFile();
+    std::string error;
+    if (!insertCourse(code, name, instructor, credits, maxCapacity, error)) {
+        UI::printError(error);
+        return;
+    }
     
     UI::printSuccess("Course added successfully!");
 }
 
-void StudentManagement::displayAllCourses() const {
+bool StudentManagement::insertCourse(const std::string& code, const std::string& name,
+                                     const std::string& instructor, int credits, int maxCapacity,
+                                     std::string& error) {
+    if (code.empty() || !isCourseCodeUnique(code)) {
+        error = "Course code '" + code + "' is empty or already exists";
+        return false;
+    }
+    if (name.empty() || instructor.empty()) {
+        error = "Course name and instructor are required";
+        return false;
+    }
+    if (credits < 1 || credits > 10 || maxCapacity < 1 || maxCapacity > 200) {
+        error = "Credits must be 1-10 and capacity 1-200";
+        return false;
+    }
+    
+    int id = generateCourseId();
+    maxCourseId = id;
+    
+    CourseHandle handle = courses.emplace(id, code, name, instructor, credits, maxCapacity);
+    codeIndex.insert(code, handle);
+    logMutation(JournalOp::AddCourse, courseFields(*courses.get(handle)));
+    return true;
+}
+
+void StudentManagement::displayAllCourses(std::ostream& out) const {
     if (courses.empty()) {
         UI::printInfo("No courses found!");
         return;
     }
     
-    UI::printTitle("All Courses");
+    ReportWriter report(out);
+    report.title("All Courses");
     
-    std::cout << "+------------+---------------------------+----------------------+---------+---------+" << std::endl;
-    std::cout << "| " << Color::cyan << "Code" << Color::reset 
-              << "       | " << Color::cyan << "Name" << Color::reset 
-              << "                        | " << Color::cyan << "Instructor" << Color::reset 
-              << "           | " << Color::cyan << "Credits" << Color::reset 
-              << " | " << Color::cyan << "Enrolled" << Color::reset << " |" << std::endl;
-    std::cout << "+------------+---------------------------+----------------------+---------+---------+" << std::endl;
+    report.text("+------------+---------------------------+----------------------+---------+---------+").endLine();
+    report.text("| ").color(Color::cyan).text("Code").color(Color::reset)
+          .text("       | ").color(Color::cyan).text("Name").color(Color::reset)
+          .text("                        | ").color(Color::cyan).text("Instructor").color(Color::reset)
+          .text("           | ").color(Color::cyan).text("Credits").color(Color::reset)
+          .text(" | ").color(Color::cyan).text("Enrolled").color(Color::reset).text(" |").endLine();
+    report.text("+------------+---------------------------+----------------------+---------+---------+").endLine();
     
     for (const auto& course : courses) {
-        course.display();
+        course.display(report);
     }
     
-    std::cout << "+------------+---------------------------+----------------------+---------+---------+" << std::endl;
-    std::cout << "| Total courses: " << std::left << std::setw(49) << courses.size() << " |" << std::endl;
-    std::cout << "+------------+---------------------------+----------------------+---------+---------+" << std::endl;
+    report.text("+------------+---------------------------+----------------------+---------+---------+").endLine();
+    report.text("| Total courses: ").cell(courses.size(), 49).text(" |").endLine();
+    report.text("+------------+---------------------------+----------------------+---------+---------+").endLine();
 }
 
 Course* StudentManagement::searchCourseByCode(const std::string& code) {
-    for (auto& course : courses) {
-        if (course.getCode() == code) {
-            return &course;
-        }
-    }
-    return nullptr;
+    return courses.get(findCourseHandle(code));
 }
 
 const Course* StudentManagement::searchCourseByCode(const std::string& code) const {
-    for (const auto& course : courses) {
-        if (course.getCode() == code) {
-            return &course;
-        }
-    }
-    return nullptr;
+    return courses.get(findCourseHandle(code));
 }
 
 void StudentManagement::updateCourse(const std::string& code) {
@@ -475,17 +1024,20 @@ void StudentManagement::updateCourse(const std::string& code) {
         return;
     }
     
-    UI::printTitle("Update Course");
-    course->displayDetailed();
+    {
+        ReportWriter report(std::cout);
+        report.title("Update Course");
+        course->displayDetailed(report);
+    }
     
     std::cout << "\nEnter new details (leave empty to keep current):\n";
     
-    std::string name = Validation::getString("Enter new name [" + course->getName() + "]: ", true);
+    std::string name = Validation::getString("Enter new name [" + std::string(course->getName()) + "]: ", true);
     if (!name.empty()) {
         course->setName(name);
     }
     
-    std::string instructor = Validation::getString("Enter new instructor [" + course->getInstructor() + "]: ", true);
+    std::string instructor = Validation::getString("Enter new instructor [" + std::string(course->getInstructor()) + "]: ", true);
     if (!instructor.empty()) {
         course->setInstructor(instructor);
     }
@@ -502,35 +1054,39 @@ void StudentManagement::updateCourse(const std::string& code) {
         course->setMaxCapacity(maxCapacity);
     }
     
-    saveCoursesToFile();
+    logMutation(JournalOp::UpdateCourse, courseFields(*course));
     UI::printSuccess("Course updated successfully!");
 }
 
 void StudentManagement::deleteCourse(const std::string& code) {
-    auto it = std::find_if(courses.begin(), courses.end(), [&code](const Course& c) {
-        return c.getCode() == code;
-    });
+    const Course* course = searchCourseByCode(code);
     
-    if (it != courses.end()) {
-        // Remove course from all students
-        for (auto& student : students) {
-            for (auto* enrolledCourse : student.getEnrolledCourses()) {
-                if (enrolledCourse->getCode() == code) {
-                    student.dropCourse(enrolledCourse);
-                    break;
-                }
-            }
-        }
-        
-        courses.erase(it);
-        saveCoursesToFile();
-        saveEnrollmentsToFile();
+    if (course) {
+        int id = course->getId();
+        eraseCourse(findCourseHandle(code));
+        logMutation(JournalOp::DeleteCourse, {std::to_string(id)});
         UI::printSuccess("Course with code " + code + " deleted successfully!");
     } else {
         UI::printError("Course with code " + code + " not found!");
     }
 }
 
+std::size_t StudentManagement::deleteCourses(const std::vector<std::string>& codes) {
+    std::size_t deleted = 0;
+    for (const auto& code : codes) {
+        CourseHandle handle = findCourseHandle(code);
+        const Course* course = courses.get(handle);
+        if (!course) {
+            continue;
+        }
+        int id = course->getId();
+        eraseCourse(handle);
+        logMutation(JournalOp::DeleteCourse, {std::to_string(id)});
+        deleted++;
+    }
+    return deleted;
+}
+
 // Enrollment management methods
 void StudentManagement::enrollStudentInCourse() {
     UI::printTitle("Enroll Student in Course");
@@ -542,7 +1098,8 @@ void StudentManagement::enrollStudentInCourse() {
     }
     
     int rollNo = Validation::getInteger("\nEnter student roll number: ", 1);
-    Student* student = searchStudentByRoll(rollNo);
+    StudentHandle studentHandle = findStudentHandle(rollNo);
+    Student* student = students.get(studentHandle);
     
     if (!student) {
         UI::printError("Student with roll number " + std::to_string(rollNo) + " not found!");
@@ -559,35 +1116,51 @@ void StudentManagement::enrollStudentInCourse() {
     }
     
     std::string code = Validation::getString("\nEnter course code: ");
-    Course* course = searchCourseByCode(code);
+    std::string error;
+    if (!enroll(rollNo, code, error)) {
+        UI::printError(error);
+        return;
+    }
     
+    UI::printSuccess("Student successfully enrolled in the course!");
+}
+
+bool StudentManagement::enroll(int rollNo, const std::string& code, std::string& error) {
+    StudentHandle studentHandle = findStudentHandle(rollNo);
+    Student* student = students.get(studentHandle);
+    if (!student) {
+        error = "Student with roll number " + std::to_string(rollNo) + " not found!";
+        return false;
+    }
+    
+    CourseHandle courseHandle = findCourseHandle(code);
+    Course* course = courses.get(courseHandle);
     if (!course) {
-        UI::printError("Course with code " + code + " not found!");
-        return;
+        error = "Course with code " + code + " not found!";
+        return false;
     }
     
     if (course->isFull()) {
-        UI::printError("Course is full. Cannot enroll more students!");
-        return;
+        error = "Course is full. Cannot enroll more students!";
+        return false;
     }
     
-    if (student->isEnrolledIn(course)) {
-        UI::printError("Student is already enrolled in this course!");
-        return;
+    if (student->isEnrolledIn(courseHandle)) {
+        error = "Student is already enrolled in this course!";
+        return false;
     }
     
-    student->enrollCourse(course);
-    course->addStudent(student);
-    
-    saveEnrollmentsToFile();
-    UI::printSuccess("Student successfully enrolled in the course!");
+    linkEnrollment(studentHandle, courseHandle);
+    logMutation(JournalOp::Enroll, {std::to_string(student->getId()), std::to_string(course->getId())});
+    return true;
 }
 
 void StudentManagement::dropStudentFromCourse() {
     UI::printTitle("Drop Student from Course");
     
     int rollNo = Validation::getInteger("Enter student roll number: ", 1);
-    Student* student = searchStudentByRoll(rollNo);
+    StudentHandle studentHandle = findStudentHandle(rollNo);
+    Student* student = students.get(studentHandle);
     
     if (!student) {
         UI::printError("Student with roll number " + std::to_string(rollNo) + " not found!");
@@ -603,21 +1176,43 @@ void StudentManagement::dropStudentFromCourse() {
     
     std::cout << "\nCourses enrolled by " << student->getName() << ":" << std::endl;
     for (size_t i = 0; i < enrolledCourses.size(); i++) {
-        std::cout << (i + 1) << ". " << enrolledCourses[i]->getCode() 
-                  << " - " << enrolledCourses[i]->getName() << std::endl;
+        const Course* course = courses.get(enrolledCourses[i]);
+        std::cout << (i + 1) << ". " << course->getCode() 
+                  << " - " << course->getName() << std::endl;
     }
     
     int choice = Validation::getInteger("\nSelect course number to drop (1-" + std::to_string(enrolledCourses.size()) + "): ", 
                                        1, enrolledCourses.size());
     
-    Course* course = enrolledCourses[choice - 1];
-    student->dropCourse(course);
-    course->removeStudent(student);
+    CourseHandle courseHandle = enrolledCourses[choice - 1];
+    Course* course = courses.get(courseHandle);
+    student->dropCourse(courseHandle);
+    course->removeStudent(studentHandle);
     
-    saveEnrollmentsToFile();
+    logMutation(JournalOp::Drop, {std::to_string(student->getId()), std::to_string(course->getId())});
     UI::printSuccess("Student successfully dropped from the course!");
 }
 
+bool StudentManagement::drop(int rollNo, const std::string& code, std::string& error) {
+    StudentHandle studentHandle = findStudentHandle(rollNo);
+    Student* student = students.get(studentHandle);
+    CourseHandle courseHandle = findCourseHandle(code);
+    Course* course = courses.get(courseHandle);
+    if (!student || !course) {
+        error = "Unknown student " + std::to_string(rollNo) + " or course " + code;
+        return false;
+    }
+    if (!student->isEnrolledIn(courseHandle)) {
+        error = "Student " + std::to_string(rollNo) + " is not enrolled in " + code;
+        return false;
+    }
+    
+    student->dropCourse(courseHandle);
+    course->removeStudent(studentHandle);
+    logMutation(JournalOp::Drop, {std::to_string(student->getId()), std::to_string(course->getId())});
+    return true;
+}
+
 void StudentManagement::displayEnrollmentDetails(int rollNo) const {
     const Student* student = searchStudentByRoll(rollNo);
     
@@ -626,8 +1221,9 @@ void StudentManagement::displayEnrollmentDetails(int rollNo) const {
         return;
     }
     
-    UI::printTitle("Enrollment Details");
-    student->displayDetailed();
+    ReportWriter report(std::cout);
+    report.title("Enrollment Details");
+    student->displayDetailed(courses, report);
 }
 
 void StudentManagement::displayCourseEnrollment(const std::string& code) const {
@@ -638,30 +1234,35 @@ void StudentManagement::displayCourseEnrollment(const std::string& code) const {
         return;
     }
     
-    UI::printTitle("Course Enrollment");
-    course->displayEnrollmentList();
+    ReportWriter report(std::cout);
+    report.title("Course Enrollment");
+    course->displayEnrollmentList(students, report);
 }
 
 // I'm particularly proud of these reporting features I added to provide useful insights
 // The grade report helps identify students' academic performance at a glance
-void StudentManagement::generateGradeReport() const {
+void StudentManagement::generateGradeReport(std::ostream& out) const {
     if (students.empty()) {
         UI::printInfo("No students found!");
         return;
     }
     
-    UI::printTitle("Grade Report");
-    
-    std::cout << "+----------+----------------------+-------+-----------------+" << std::endl;
-    std::cout << "| " << Color::cyan << "Roll No" << Color::reset 
-              << "   | " << Color::cyan << "Name" << Color::reset 
-              << "                 | " << Color::cyan << "Grade" << Color::reset 
-              << " | " << Color::cyan << "Grade Letter" << Color::reset << "     |" << std::endl;
-    std::cout << "+----------+----------------------+-------+-----------------+" << std::endl;
-    
-    for (const auto& student : students) {
-        float grade = student.getGrade();
-        std::string gradeLetter;
+    ReportWriter report(out);
+    report.title("Grade Report");
+    
+    report.text("+----------+----------------------+-------+-----------------+").endLine();
+    report.text("| ").color(Color::cyan).text("Roll No").color(Color::reset)
+          .text("   | ").color(Color::cyan).text("Name").color(Color::reset)
+          .text("                 | ").color(Color::cyan).text("Grade").color(Color::reset)
+          .text(" | ").color(Color::cyan).text("Grade Letter").color(Color::reset).text("     |").endLine();
+    report.text("+----------+----------------------+-------+-----------------+").endLine();
+    
+    // Grades and roll numbers come from the analytics columns; only the name is read from the record
+    const auto& grades = analytics.grades();
+    const auto& rollNumbers = analytics.rollNumbers();
+    for (std::size_t i = 0; i < analytics.size(); i++) {
+        float grade = grades[i];
+        const char* gradeLetter;
         
         if (grade >= 90) gradeLetter = "A (Excellent)";
         else if (grade >= 80) gradeLetter = "B (Very Good)";
@@ -670,46 +1271,213 @@ void StudentManagement::generateGradeReport() const {
         else if (grade >= 50) gradeLetter = "E (Pass)";
         else gradeLetter = "F (Fail)";
         
-        std::cout << "| " << std::left << std::setw(8) << student.getRollNo() 
-                  << " | " << std::setw(20) << student.getName() 
-                  << " | " << std::setw(5) << grade 
-                  << " | " << std::setw(15) << gradeLetter << " |" << std::endl;
+        report.text("| ").cell(rollNumbers[i], 8)
+              .text(" | ").cell(students[i].getName(), 20)
+              .text(" | ").cell(grade, 5)
+              .text(" | ").cell(gradeLetter, 15).text(" |").endLine();
     }
     
-    std::cout << "+----------+----------------------+-------+-----------------+" << std::endl;
+    report.text("+----------+----------------------+-------+-----------------+").endLine();
+    
+    Kernels::RosterHistogram histogram = getRosterHistogram();
+    const char* letters[6] = {"A", "B", "C", "D", "E", "F"};
+    report.text("Distribution:");
+    for (int k = 0; k < 6; k++) {
+        report.text(" ").text(letters[k]).text("=").cell(histogram.grade[k], 0);
+    }
+    report.endLine();
 }
 
-void StudentManagement::generateAttendanceReport() const {
+void StudentManagement::generateAttendanceReport(std::ostream& out) const {
     if (students.empty()) {
         UI::printInfo("No students found!");
         return;
     }
     
-    UI::printTitle("Attendance Report");
-    
-    std::cout << "+----------+----------------------+------------+-----------------+" << std::endl;
-    std::cout << "| " << Color::cyan << "Roll No" << Color::reset 
-              << "   | " << Color::cyan << "Name" << Color::reset 
-              << "                 | " << Color::cyan << "Attendance" << Color::reset 
-              << " | " << Color::cyan << "Status" << Color::reset << "          |" << std::endl;
-    std::cout << "+----------+----------------------+------------+-----------------+" << std::endl;
-    
-    for (const auto& student : students) {
-        float attendance = student.getAttendance();
-        std::string status;
+    ReportWriter report(out);
+    report.title("Attendance Report");
+    
+    report.text("+----------+----------------------+------------+-----------------+").endLine();
+    report.text("| ").color(Color::cyan).text("Roll No").color(Color::reset)
+          .text("   | ").color(Color::cyan).text("Name").color(Color::reset)
+          .text("                 | ").color(Color::cyan).text("Attendance").color(Color::reset)
+          .text(" | ").color(Color::cyan).text("Status").color(Color::reset).text("          |").endLine();
+    report.text("+----------+----------------------+------------+-----------------+").endLine();
+    
+    const auto& attendanceColumn = analytics.attendance();
+    const auto& rollNumbers = analytics.rollNumbers();
+    for (std::size_t i = 0; i < analytics.size(); i++) {
+        float attendance = attendanceColumn[i];
+        const char* status;
         
         if (attendance >= 90) status = "Excellent";
         else if (attendance >= 80) status = "Good";
         else if (attendance >= 75) status = "Satisfactory";
         else status = "Low (Warning)";
         
-        std::cout << "| " << std::left << std::setw(8) << student.getRollNo() 
-                  << " | " << std::setw(20) << student.getName() 
-                  << " | " << std::setw(10) << attendance << "% | " 
-                  << std::setw(15) << status << " |" << std::endl;
+        report.text("| ").cell(rollNumbers[i], 8)
+              .text(" | ").cell(students[i].getName(), 20)
+              .text(" | ").cell(attendance, 10).text("% | ")
+              .cell(status, 15).text(" |").endLine();
     }
     
-    std::cout << "+----------+----------------------+------------+-----------------+" << std::endl;
+    report.text("+----------+----------------------+------------+-----------------+").endLine();
+    
+    Kernels::RosterHistogram histogram = getRosterHistogram();
+    report.text("Distribution: Excellent=").cell(histogram.attendance[0], 0)
+          .text(" Good=").cell(histogram.attendance[1], 0)
+          .text(" Satisfactory=").cell(histogram.attendance[2], 0)
+          .text(" Low=").cell(histogram.attendance[3], 0).endLine();
+}
+
+// What one interned column costs now and what a string in every record would cost
+struct ColumnMemory {
+    const char* column = nullptr;
+    std::size_t records = 0;
+    std::size_t perRecordBytes = 0;
+    StringPoolStats pool = {};
+};
+
+// A per-record copy is a string object plus, past the inline buffer, its characters
+static std::size_t copiedBytes(std::string_view text) {
+    static const std::size_t inlineCapacity = std::pmr::string().capacity();
+    return sizeof(std::pmr::string) + (text.size() > inlineCapacity ? text.size() + 1 : 0);
+}
+
+static void printColumnMemory(const ColumnMemory& usage, ReportWriter& out) {
+    std::size_t internedBytes = usage.records * sizeof(StringId) + usage.pool.textBytes + usage.pool.indexBytes;
+    double saved = usage.perRecordBytes > 0
+        ? 100.0 * (static_cast<double>(usage.perRecordBytes) - static_cast<double>(internedBytes)) / usage.perRecordBytes
+        : 0.0;
+    out.text("| ").cell(usage.column, 18)
+       .text(" | ").rightCell(usage.records, 9)
+       .text(" | ").rightCell(usage.pool.distinct, 9)
+       .text(" | ").rightCell(usage.perRecordBytes / 1024, 12)
+       .text(" | ").rightCell(internedBytes / 1024, 12)
+       .text(" | ").rightCell(saved, 7, 1).text("% |").endLine();
+}
+
+void StudentManagement::printMemoryReport(std::ostream& out) const {
+    ReportWriter report(out);
+    report.title("Memory Report");
+
+    ColumnMemory addresses{"Student address"};
+    for (const auto& student : students) {
+        addresses.records++;
+        addresses.perRecordBytes += copiedBytes(student.getAddress());
+    }
+    ColumnMemory names{"Course name"};
+    ColumnMemory instructors{"Course instructor"};
+    for (const auto& course : courses) {
+        names.records++;
+        names.perRecordBytes += copiedBytes(course.getName());
+        instructors.records++;
+        instructors.perRecordBytes += copiedBytes(course.getInstructor());
+    }
+    addresses.pool = StringPool::addresses().stats();
+    names.pool = StringPool::courseNames().stats();
+    instructors.pool = StringPool::instructors().stats();
+
+    report.text("+--------------------+-----------+-----------+--------------+--------------+----------+").endLine();
+    report.text("| ").color(Color::cyan).text("Column").color(Color::reset)
+          .text("             | ").color(Color::cyan).text("  Records").color(Color::reset)
+          .text(" | ").color(Color::cyan).text(" Distinct").color(Color::reset)
+          .text(" | ").color(Color::cyan).text("  Copies KiB").color(Color::reset)
+          .text(" | ").color(Color::cyan).text("Interned KiB").color(Color::reset)
+          .text(" | ").color(Color::cyan).text("   Saved").color(Color::reset).text(" |").endLine();
+    report.text("+--------------------+-----------+-----------+--------------+--------------+----------+").endLine();
+    printColumnMemory(addresses, report);
+    printColumnMemory(names, report);
+    printColumnMemory(instructors, report);
+    report.text("+--------------------+-----------+-----------+--------------+--------------+----------+").endLine();
+
+    // The pools keep every value interned since start, including ones edited away since
+    report.text("Interned sizes include the 4 byte id in each record, the stored text and the pool's lookup tables.").endLine();
+    if (arena) {
+        report.text("Record arena: ").cell(arena->heapBlocks(), 0).text(" blocks, ")
+              .cell(arena->heapBytes() / 1024, 0).text(" KiB for the other strings and the enrollment sets").endLine();
+    }
+}
+
+// The secondary indexes can be switched off, e.g. around bulk changes, and are rebuilt
+// in one go when switched back on; without them the views fall back to scanning
+void StudentManagement::setSecondaryIndexesEnabled(bool enabled) {
+    secondaryIndexesEnabled = enabled;
+    rebuildSecondaryIndexes();
+}
+
+void StudentManagement::rebuildSecondaryIndexes() {
+    nameIndex.clear();
+    gradeIndex.clear();
+    for (std::size_t i = 0; i < students.size(); i++) {
+        indexStudent(students.handleAt(i));
+    }
+}
+
+void StudentManagement::indexStudent(StudentHandle handle) {
+    const Student* student = students.get(handle);
+    if (!secondaryIndexesEnabled || !student) {
+        return;
+    }
+    nameIndex.update(handle, std::string(student->getName()));
+    gradeIndex.update(handle, student->getGrade());
+}
+
+void StudentManagement::unindexStudent(StudentHandle handle) {
+    nameIndex.erase(handle);
+    gradeIndex.erase(handle);
+}
+
+// Letter grade and attendance status counts for the whole roster, from one vectorized pass
+Kernels::RosterHistogram StudentManagement::getRosterHistogram() const {
+    return Kernels::rosterHistogram(analytics.grades().data(), analytics.attendance().data(), analytics.size());
+}
+
+// The grade index answers in O(K); without it a partial selection over the grade column is used
+std::vector<const Student*> StudentManagement::findTopPerformers(int count) const {
+    std::vector<const Student*> top;
+    if (secondaryIndexesEnabled) {
+        for (StudentHandle handle : gradeIndex.first(count)) {
+            top.push_back(students.get(handle));
+        }
+    } else {
+        for (std::size_t row : TopK::largest(analytics.grades(), count)) {
+            top.push_back(&students[row]);
+        }
+    }
+    return top;
+}
+
+// Range query on the grade index, highest grade first
+std::vector<const Student*> StudentManagement::findStudentsByGradeRange(float minGrade, float maxGrade) const {
+    std::vector<const Student*> found;
+    if (secondaryIndexesEnabled) {
+        // The index is ordered from high to low grades, so the range starts at maxGrade
+        gradeIndex.forEachInRange(maxGrade, minGrade, [this, &found](StudentHandle handle) {
+            found.push_back(students.get(handle));
+        });
+    } else {
+        for (std::size_t row : TopK::largest(analytics.grades(), analytics.size())) {
+            float grade = analytics.grades()[row];
+            if (grade >= minGrade && grade <= maxGrade) {
+                found.push_back(&students[row]);
+            }
+        }
+    }
+    return found;
+}
+
+// The vectorized kernel builds a selection bitmask; only selected rows are collected
+std::vector<const Student*> StudentManagement::findStudentsByAttendance(float minAttendance) const {
+    std::vector<std::uint64_t> selected;
+    Kernels::selectMask(analytics.attendance().data(), analytics.size(),
+                        Kernels::Compare::GreaterEqual, minAttendance, selected);
+    
+    std::vector<const Student*> found;
+    Kernels::forEachSelected(selected, [this, &found](std::size_t row) {
+        found.push_back(&students[row]);
+    });
+    return found;
 }
 
 void StudentManagement::showTopPerformers(int count) const {
@@ -718,77 +1486,109 @@ void StudentManagement::showTopPerformers(int count) const {
         return;
     }
     
-    // Create a copy of students vector to sort
-    std::vector<Student> sortedStudents = students;
-    
-    // Sort by grade in descending order
-    std::sort(sortedStudents.begin(), sortedStudents.end(), [](const Student& a, const Student& b) {
-        return a.getGrade() > b.getGrade();
-    });
-    
-    // Take only the requested number of students
-    count = std::min(static_cast<int>(sortedStudents.size()), count);
+    std::vector<const Student*> top = findTopPerformers(count);
+    count = static_cast<int>(top.size());
     
-    UI::printTitle("Top " + std::to_string(count) + " Performers");
+    ReportWriter report(std::cout);
+    report.title("Top " + std::to_string(count) + " Performers");
     
-    std::cout << "+------+----------+----------------------+-------+------------+" << std::endl;
-    std::cout << "| " << Color::cyan << "Rank" << Color::reset 
-              << " | " << Color::cyan << "Roll No" << Color::reset 
-              << "   | " << Color::cyan << "Name" << Color::reset 
-              << "                 | " << Color::cyan << "Grade" << Color::reset 
-              << " | " << Color::cyan << "Attendance" << Color::reset << " |" << std::endl;
-    std::cout << "+------+----------+----------------------+-------+------------+" << std::endl;
+    report.text("+------+----------+----------------------+-------+------------+").endLine();
+    report.text("| ").color(Color::cyan).text("Rank").color(Color::reset)
+          .text(" | ").color(Color::cyan).text("Roll No").color(Color::reset)
+          .text("   | ").color(Color::cyan).text("Name").color(Color::reset)
+          .text("                 | ").color(Color::cyan).text("Grade").color(Color::reset)
+          .text(" | ").color(Color::cyan).text("Attendance").color(Color::reset).text(" |").endLine();
+    report.text("+------+----------+----------------------+-------+------------+").endLine();
     
     for (int i = 0; i < count; i++) {
-        std::cout << "| " << std::left << std::setw(4) << (i + 1) 
-                  << " | " << std::setw(8) << sortedStudents[i].getRollNo() 
-                  << " | " << std::setw(20) << sortedStudents[i].getName() 
-                  << " | " << std::setw(5) << sortedStudents[i].getGrade() 
-                  << " | " << std::setw(10) << sortedStudents[i].getAttendance() << "% |" << std::endl;
+        const Student& student = *top[i];
+        report.text("| ").cell(i + 1, 4)
+              .text(" | ").cell(student.getRollNo(), 8)
+              .text(" | ").cell(student.getName(), 20)
+              .text(" | ").cell(student.getGrade(), 5)
+              .text(" | ").cell(student.getAttendance(), 10).text("% |").endLine();
     }
     
-    std::cout << "+------+----------+----------------------+-------+------------+" << std::endl;
+    report.text("+------+----------+----------------------+-------+------------+").endLine();
 }
 
 // I implemented these sorting and filtering functions to make data analysis easier
-// Using C++ lambdas here made the code much cleaner and more maintainable
-void StudentManagement::sortStudentsByName() {
-    std::sort(students.begin(), students.end(), [](const Student& a, const Student& b) {
-        return a.getName() < b.getName();
-    });
+// Sorted views walk the secondary indexes, so the store itself is never reordered
+void StudentManagement::sortStudentsByName() const {
+    if (students.empty()) {
+        UI::printInfo("No students found!");
+        return;
+    }
     
     UI::printSuccess("Students sorted by name.");
-    displayAllStudents();
+    ReportWriter report(std::cout);
+    report.title("All Students");
+    printStudentTableHeader(report);
+    
+    if (secondaryIndexesEnabled) {
+        nameIndex.forEach([this, &report](StudentHandle handle) { students.get(handle)->display(report); });
+    } else {
+        std::vector<const Student*> order;
+        for (const auto& student : students) {
+            order.push_back(&student);
+        }
+        std::stable_sort(order.begin(), order.end(), [](const Student* a, const Student* b) {
+            return a->getName() < b->getName();
+        });
+        for (const Student* student : order) {
+            student->display(report);
+        }
+    }
+    
+    printStudentTableFooter(report, "Total students: ", students.size());
 }
 
-void StudentManagement::sortStudentsByGrade() {
-    std::sort(students.begin(), students.end(), [](const Student& a, const Student& b) {
-        return a.getGrade() > b.getGrade();
-    });
+void StudentManagement::sortStudentsByGrade() const {
+    if (students.empty()) {
+        UI::printInfo("No students found!");
+        return;
+    }
     
     UI::printSuccess("Students sorted by grade (descending).");
-    displayAllStudents();
+    ReportWriter report(std::cout);
+    report.title("All Students");
+    printStudentTableHeader(report);
+    
+    if (secondaryIndexesEnabled) {
+        gradeIndex.forEach([this, &report](StudentHandle handle) { students.get(handle)->display(report); });
+    } else {
+        for (std::size_t row : TopK::largest(analytics.grades(), analytics.size())) {
+            students[row].display(report);
+        }
+    }
+    
+    printStudentTableFooter(report, "Total students: ", students.size());
 }
 
-void StudentManagement::filterStudentsByAttendance(float minAttendance) const {
-    UI::printTitle("Students with Attendance >= " + std::to_string(minAttendance) + "%");
+void StudentManagement::filterStudentsByGradeRange(float minGrade, float maxGrade) const {
+    ReportWriter report(std::cout);
+    report.title("Students with Grade " + std::to_string(minGrade) + " - " + std::to_string(maxGrade));
+    printStudentTableHeader(report);
+    
+    std::vector<const Student*> found = findStudentsByGradeRange(minGrade, maxGrade);
+    for (const Student* student : found) {
+        student->display(report);
+    }
     
-    std::cout << "+----------------------+----------+-------+------------+" << std::endl;
-    std::cout << "| " << Color::cyan << "Name" << Color::reset 
-              << "                 | " << Color::cyan << "Roll No" << Color::reset 
-              << "  | " << Color::cyan << "Grade" << Color::reset 
-              << " | " << Color::cyan << "Attendance" << Color::reset << " |" << std::endl;
-    std::cout << "+----------------------+----------+-------+------------+" << std::endl;
+    printStudentTableFooter(report, "Filtered students: ", found.size());
+}
+
+void StudentManagement::filterStudentsByAttendance(float minAttendance) const {
+    ReportWriter report(std::cout);
+    report.title("Students with Attendance >= " + std::to_string(minAttendance) + "%");
+    printStudentTableHeader(report);
     
-    int count = 0;
-    for (const auto& student : students) {
-        if (student.getAttendance() >= minAttendance) {
-            student.display();
-            count++;
-        }
+    std::vector<const Student*> found = findStudentsByAttendance(minAttendance);
+    for (const Student* student : found) {
+        student->display(report);
     }
     
-    std::cout << "+----------------------+----------+-------+------------+" << std::endl;
-    std::cout << "| Filtered students: " << std::left << std::setw(17) << count << " |" << std::endl;
-    std::cout << "+----------------------+----------+-------+------------+" << std::endl;
+    report.text("+----------------------+----------+-------+------------+").endLine();
+    report.text("| Filtered students: ").cell(found.size(), 17).text(" |").endLine();
+    report.text("+----------------------+----------+-------+------------+").endLine();
 }
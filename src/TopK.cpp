@@ -0,0 +1,24 @@
+#include "../include/TopK.h"
+#include <algorithm>
+#include <numeric>
+
+std::vector<std::size_t> TopK::largest(const std::vector<float>& values, std::size_t k) {
+    std::vector<std::size_t> rows(values.size());
+    std::iota(rows.begin(), rows.end(), 0);
+    k = std::min(k, rows.size());
+
+    auto better = [&values](std::size_t a, std::size_t b) {
+        if (values[a] != values[b]) {
+            return values[a] > values[b];
+        }
+        return a < b;
+    };
+
+    // nth_element moves the k winners to the front in linear time, then only they get sorted
+    if (k < rows.size()) {
+        std::nth_element(rows.begin(), rows.begin() + k, rows.end(), better);
+    }
+    rows.resize(k);
+    std::sort(rows.begin(), rows.end(), better);
+    return rows;
+}
@@ -1,6 +1,13 @@
 #include "../include/Utils.h"
 #include <iostream>
 #include <stdlib.h>
+#include <algorithm>
+#include <cctype>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
 
 // I created these UI helper functions to make my CLI interface look more professional
 // The clearScreen function works cross-platform (Windows and Linux/Mac)
@@ -14,31 +21,38 @@ void UI::clearScreen() {
 
 void UI::printTitle(const std::string& title) {
     int padding = (50 - title.length()) / 2;
-    std::cout << Color::cyan << Color::bold;
+    bool colors = usesColors(std::cout);
+    std::cout << (colors ? Color::cyan + Color::bold : "");
     printSeparator('=', 50);
     std::cout << std::string(padding, ' ') << title << std::endl;
     printSeparator('=', 50);
-    std::cout << Color::reset << std::endl;
+    std::cout << (colors ? Color::reset : "") << std::endl;
 }
 
 void UI::printSeparator(char symbol, int length) {
     std::cout << std::string(length, symbol) << std::endl;
 }
 
+// stderr is tied to stdout, so a status line still comes out after everything printed before it
+static void printStatus(const std::string& color, const char* tag, const std::string& message) {
+    bool colors = UI::usesColors(std::cerr);
+    std::cerr << (colors ? color : "") << tag << message << (colors ? Color::reset : "") << std::endl;
+}
+
 void UI::printSuccess(const std::string& message) {
-    std::cout << Color::green << "[SUCCESS] " << message << Color::reset << std::endl;
+    printStatus(Color::green, "[SUCCESS] ", message);
 }
 
 void UI::printError(const std::string& message) {
-    std::cout << Color::red << "[ERROR] " << message << Color::reset << std::endl;
+    printStatus(Color::red, "[ERROR] ", message);
 }
 
 void UI::printWarning(const std::string& message) {
-    std::cout << Color::yellow << "[WARNING] " << message << Color::reset << std::endl;
+    printStatus(Color::yellow, "[WARNING] ", message);
 }
 
 void UI::printInfo(const std::string& message) {
-    std::cout << Color::blue << "[INFO] " << message << Color::reset << std::endl;
+    printStatus(Color::blue, "[INFO] ", message);
 }
 
 void UI::pressEnterToContinue() {
@@ -47,6 +61,20 @@ void UI::pressEnterToContinue() {
     std::cin.get();
 }
 
+bool UI::usesColors(const std::ostream& out) {
+    #ifdef _WIN32
+        static const bool stdoutTerminal = _isatty(_fileno(stdout)) != 0;
+        static const bool stderrTerminal = _isatty(_fileno(stderr)) != 0;
+    #else
+        static const bool stdoutTerminal = isatty(STDOUT_FILENO) != 0;
+        static const bool stderrTerminal = isatty(STDERR_FILENO) != 0;
+    #endif
+    if (&out == &std::cout) {
+        return stdoutTerminal;
+    }
+    return &out == &std::cerr && stderrTerminal;
+}
+
 // Input validation functions
 int Validation::getInteger(const std::string& prompt, int min, int max) {
     int value;
@@ -160,14 +188,68 @@ bool Validation::isAlphanumeric(const std::string& str) {
     });
 }
 
-bool Validation::isValidEmail(const std::string& email) {
-    // Simple email validation regex
-    const std::regex pattern("(\\w+)(\\.|_)?(\\w*)@(\\w+)(\\.(\\w+))+");
-    return std::regex_match(email, pattern);
+// Hand-written matchers with the same acceptance as the regexes they replaced:
+//   email  (\w+)(\.|_)?(\w*)@(\w+)(\.(\w+))+
+//   phone  [\d\s\-\(\)]+ and at least 6 characters
+// One pass over the text, no allocations; bulk imports call these for every row
+static bool isWordChar(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
 }
 
-bool Validation::isValidPhone(const std::string& phone) {
-    // Simple phone validation - allowing digits, spaces, dashes, parentheses
-    const std::regex pattern("[\\d\\s\\-\\(\\)]+");
-    return std::regex_match(phone, pattern) && phone.length() >= 6;
+bool Validation::isValidEmail(std::string_view email) {
+    std::size_t at = email.find('@');
+    if (at == std::string_view::npos) {
+        return false;
+    }
+    
+    // The local part is word characters with at most one dot, and not at the start
+    // (an underscore between the groups is just another word character)
+    std::string_view local = email.substr(0, at);
+    if (local.empty() || !isWordChar(local[0])) {
+        return false;
+    }
+    bool seenDot = false;
+    for (char c : local) {
+        if (c == '.') {
+            if (seenDot) {
+                return false;
+            }
+            seenDot = true;
+        } else if (!isWordChar(c)) {
+            return false;
+        }
+    }
+    
+    // The domain is two or more non-empty runs of word characters joined by dots
+    std::size_t dots = 0;
+    std::size_t labelLength = 0;
+    for (char c : email.substr(at + 1)) {
+        if (c == '.') {
+            if (labelLength == 0) {
+                return false;
+            }
+            dots++;
+            labelLength = 0;
+        } else if (isWordChar(c)) {
+            labelLength++;
+        } else {
+            return false;
+        }
+    }
+    return dots > 0 && labelLength > 0;
+}
+
+bool Validation::isValidPhone(std::string_view phone) {
+    // Digits, whitespace, dashes and parentheses
+    if (phone.length() < 6) {
+        return false;
+    }
+    for (char c : phone) {
+        bool allowed = (c >= '0' && c <= '9') || c == ' ' || (c >= '\t' && c <= '\r') ||
+                       c == '-' || c == '(' || c == ')';
+        if (!allowed) {
+            return false;
+        }
+    }
+    return true;
 }
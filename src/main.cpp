@@ -1,6 +1,13 @@
 #include <iostream>
 #include "../include/StudentManagement.h"
 #include "../include/Utils.h"
+#include "../include/BatchRunner.h"
+#include "../include/ConcurrentStudentManagement.h"
+#include "../include/HttpServer.h"
+#include "../include/StudentApi.h"
+#include "../include/CsvReader.h"
+#include <csignal>
+#include <fstream>
 
 // My main program entry point for the Student Management System
 // I created this function to display a clean, organized menu with color-coded options
@@ -29,20 +36,171 @@ void displayMainMenu() {
     std::cout << Color::cyan << "18." << Color::reset << " Sort Students by Name" << std::endl;
     std::cout << Color::cyan << "19." << Color::reset << " Sort Students by Grade" << std::endl;
     std::cout << Color::cyan << "20." << Color::reset << " Filter Students by Attendance" << std::endl;
+    std::cout << Color::cyan << "21." << Color::reset << " Compact Data Files" << std::endl;
+    std::cout << Color::cyan << "22." << Color::reset << " Find Students by Grade Range" << std::endl;
     std::cout << Color::cyan << " 0." << Color::reset << " Exit" << std::endl;
     
     UI::printSeparator();
 }
 
+// The server mode runs until Ctrl+C; the handler only wakes the event loop
+static HttpServer* runningServer = nullptr;
+
+static void stopServer(int) {
+    if (runningServer) {
+        runningServer->stop();
+    }
+}
+
+// Serves the JSON API on 127.0.0.1:port until interrupted, then saves like the menu's exit
+int runServer(StudentManagement& sm, int port) {
+    ConcurrentStudentManagement store(sm);
+    HttpServer server([&store](const HttpRequest& request) { return StudentApi::handle(store, request); });
+    
+    std::string error;
+    if (!server.start(port, error)) {
+        UI::printError("Could not start the server: " + error);
+        return 1;
+    }
+    runningServer = &server;
+    std::signal(SIGINT, stopServer);
+    std::signal(SIGTERM, stopServer);
+    
+    UI::printSuccess("Serving the JSON API on http://127.0.0.1:" + std::to_string(port) + " (Ctrl+C to stop)");
+    server.run();
+    runningServer = nullptr;
+    
+    store.flushDataFiles();
+    if (!sm.flushAndWait()) {
+        UI::printError("Server stopped, but writing the data files failed. The journal was kept.");
+        return 1;
+    }
+    UI::printInfo("Server stopped, data files saved.");
+    return 0;
+}
+
+// Command line conversions between the CSV files and the binary snapshot
+// Returns -1 when the arguments are not a command, so the interactive menu starts instead
+int runCommand(StudentManagement& sm, int argc, char* argv[]) {
+    if (argc < 2) {
+        return -1;
+    }
+    
+    std::string command = argv[1];
+    std::string path = argc >= 3 ? argv[2] : "data/store.snap";
+    
+    if (command == "--export-snapshot") {
+        if (!sm.exportSnapshot(path)) {
+            UI::printError("Could not write snapshot " + path);
+            return 1;
+        }
+        UI::printSuccess("Exported CSV data to snapshot " + path);
+        return 0;
+    }
+    if (command == "--import-snapshot") {
+        if (!sm.importSnapshot(path)) {
+            UI::printError("Could not read snapshot " + path);
+            return 1;
+        }
+        if (!sm.flushAndWait()) {
+            UI::printError("Could not write the CSV files from snapshot " + path);
+            return 1;
+        }
+        UI::printSuccess("Imported snapshot " + path + " into the CSV files");
+        return 0;
+    }
+    
+    if (command == "--batch") {
+        // Commands come from a file, or from stdin with "-"
+        std::string source = argc >= 3 ? argv[2] : "-";
+        BatchReport report;
+        if (!BatchRunner::runFile(sm, source, report)) {
+            UI::printError("Could not read batch file " + source);
+            return 1;
+        }
+        BatchRunner::printReport(report);
+        if (!report.persisted) {
+            return 1;
+        }
+        return report.errors.empty() ? 0 : 2;
+    }
+    
+    if (command == "--serve") {
+        int port = 8080;
+        if (argc >= 3 && (!Csv::parseInt(argv[2], port) || port < 1 || port > 65535)) {
+            UI::printError("Invalid port " + std::string(argv[2]));
+            return 1;
+        }
+        return runServer(sm, port);
+    }
+    
+    if (command == "--report") {
+        // The report goes to stdout, or to a file when one is given
+        std::string kind = argc >= 3 ? argv[2] : "";
+        std::ofstream file;
+        if (argc >= 4) {
+            file.open(argv[3]);
+            if (!file) {
+                UI::printError("Could not write report file " + std::string(argv[3]));
+                return 1;
+            }
+        }
+        std::ostream& out = argc >= 4 ? static_cast<std::ostream&>(file) : std::cout;
+        if (kind == "grades") {
+            sm.generateGradeReport(out);
+        } else if (kind == "attendance") {
+            sm.generateAttendanceReport(out);
+        } else if (kind == "students") {
+            sm.displayAllStudents(out);
+        } else if (kind == "courses") {
+            sm.displayAllCourses(out);
+        } else {
+            UI::printError("Unknown report '" + kind + "', use grades, attendance, students or courses");
+            return 1;
+        }
+        return 0;
+    }
+    
+    if (command == "--memory-report") {
+        sm.printMemoryReport();
+        return 0;
+    }
+    
+    UI::printError("Unknown command " + command);
+    std::cerr << "Usage: " << argv[0]
+              << " [--flush immediate|exit|ops:N|ms:N] [--export-snapshot [file] | --import-snapshot [file] | --batch [file|-] | --serve [port] | --report grades|attendance|students|courses [file] | --memory-report]"
+              << std::endl;
+    return 1;
+}
+
 // My main function - the entry point of my Student Management System
 // I designed this with a menu-driven approach for intuitive user interaction
-int main() {
+int main(int argc, char* argv[]) {
     StudentManagement sm;
+    
+    // An optional "--flush <policy>" goes first and applies to every mode
+    std::vector<char*> args(argv, argv + argc);
+    if (args.size() >= 3 && std::string(args[1]) == "--flush") {
+        FlushPolicy policy;
+        if (!FlushPolicy::parse(args[2], policy)) {
+            UI::printError("Unknown flush policy " + std::string(args[2]) + " (use immediate, exit, ops:N or ms:N)");
+            return 1;
+        }
+        sm.setFlushPolicy(policy);
+        args.erase(args.begin() + 1, args.begin() + 3);
+    }
+    
+    int commandResult = runCommand(sm, static_cast<int>(args.size()), args.data());
+    if (commandResult >= 0) {
+        return commandResult;
+    }
+    
     int choice;
+    int exitCode = 0;
     
     do {
         displayMainMenu();
-        choice = Validation::getInteger("Enter your choice: ", 0, 20);
+        choice = Validation::getInteger("Enter your choice: ", 0, 22);
         
         switch (choice) {
             case 1: {
@@ -63,7 +221,8 @@ int main() {
                 int rollNo = Validation::getInteger("Enter roll number to search: ", 1);
                 const Student* student = sm.searchStudentByRoll(rollNo);
                 if (student) {
-                    student->displayDetailed();
+                    ReportWriter report(std::cout);
+                    student->displayDetailed(sm.getCourses(), report);
                 } else {
                     UI::printError("Student with roll number " + std::to_string(rollNo) + " not found!");
                 }
@@ -104,7 +263,8 @@ int main() {
                 std::string code = Validation::getString("Enter course code to search: ");
                 const Course* course = sm.searchCourseByCode(code);
                 if (course) {
-                    course->displayDetailed();
+                    ReportWriter report(std::cout);
+                    course->displayDetailed(report);
                 } else {
                     UI::printError("Course with code " + code + " not found!");
                 }
@@ -193,8 +353,39 @@ int main() {
                 UI::pressEnterToContinue();
                 break;
             }
+            case 21: {
+                UI::clearScreen();
+                sm.compactDataFiles();
+                if (sm.flushAndWait()) {
+                    UI::printSuccess("Journal folded into the data files.");
+                } else {
+                    UI::printError("Writing the data files failed. The journal was kept.");
+                }
+                
+                WriterMetrics metrics = sm.getWriterMetrics();
+                std::cout << "Background writer: " << metrics.completed << " writes, "
+                          << metrics.failed << " failed, queue depth " << metrics.queueDepth
+                          << " (max " << metrics.maxQueueDepth << "), latency avg "
+                          << metrics.averageLatencyMs << " ms, max " << metrics.maxLatencyMs << " ms" << std::endl;
+                UI::pressEnterToContinue();
+                break;
+            }
+            case 22: {
+                UI::clearScreen();
+                float minGrade = Validation::getFloat("Enter minimum grade: ", 0, 100);
+                float maxGrade = Validation::getFloat("Enter maximum grade: ", minGrade, 100);
+                sm.filterStudentsByGradeRange(minGrade, maxGrade);
+                UI::pressEnterToContinue();
+                break;
+            }
             case 0: {
                 UI::clearScreen();
+                // Write whatever is still dirty so the CSV files are up to date for other tools,
+                // and wait until the writer thread has put it on disk
+                if (!sm.flushAndWait()) {
+                    UI::printError("Writing the data files failed. The journal was kept.");
+                    exitCode = 1;
+                }
                 UI::printTitle("Exiting Program");
                 UI::printSuccess("Thank you for using Student Management System!");
                 std::cout << "Developed by: Nikhil Soni" << std::endl;
@@ -204,7 +395,10 @@ int main() {
             default:
                 UI::printError("Invalid choice! Please try again.");
         }
+        
+        // A time based flush policy can come due while the menu waits for input
+        sm.flushIfDue();
     } while (choice != 0);
     
-    return 0;
+    return exitCode;
 }
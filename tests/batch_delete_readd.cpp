@@ -0,0 +1,69 @@
+#include "../bench/Bench.h"
+#include "../include/BatchRunner.h"
+#include "../include/StudentManagement.h"
+#include <string>
+
+// Batches that delete a roll number and add it again, run against an empty store in a
+// scratch directory. The add after the delete must be accepted, while two adds of the
+// same roll number without a delete between them must still clash
+static int failures = 0;
+
+static void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cout << "FAILED: " << what << std::endl;
+        failures++;
+    }
+}
+
+static BatchReport runBatch(StudentManagement& sm, std::string commands) {
+    BatchReport report;
+    BatchRunner::run(sm, commands.data(), commands.data() + commands.size(), report);
+    return report;
+}
+
+// The first rule a line broke, or an empty string
+static std::string errorOn(const BatchReport& report, std::size_t line) {
+    for (const auto& error : report.errors) {
+        if (error.line == line) {
+            return error.field.empty() ? error.reason : error.field;
+        }
+    }
+    return "";
+}
+
+int main() {
+    Bench::ScratchDirectory scratch("batch-delete-readd");
+    StudentManagement sm;
+
+    BatchReport readd = runBatch(sm, "add-course,CS101,Intro to Programming,Dr. Rao,4,120\n"
+                                     "add-student,A,100,80,90\n"
+                                     "delete-student,100\n"
+                                     "add-student,B,100,85,95\n"
+                                     "enroll,100,CS101\n");
+    expect(readd.errors.empty(), "delete then add again is accepted");
+    expect(readd.applied == 5, "all five commands are applied");
+    const Student* student = sm.searchStudentByRoll(100);
+    expect(student && student->getName() == "B", "roll number 100 belongs to the second add");
+    expect(student && student->getEnrolledCourses().size() == 1, "the second student is enrolled in CS101");
+
+    BatchReport twice = runBatch(sm, "add-student,C,200,70,80\n"
+                                     "add-student,D,200,70,80\n");
+    expect(errorOn(twice, 1).empty(), "the first add of 200 is accepted");
+    expect(errorOn(twice, 2) == "rollNo", "a second add of 200 without a delete is rejected");
+
+    BatchReport afterDelete = runBatch(sm, "add-student,E,300,70,80\n"
+                                           "delete-student,300\n"
+                                           "add-student,F,300,70,80\n"
+                                           "add-student,G,300,70,80\n");
+    expect(errorOn(afterDelete, 3).empty(), "the add right after the delete is accepted");
+    expect(errorOn(afterDelete, 4) == "rollNo", "a second add after the same delete is rejected");
+
+    BatchReport existing = runBatch(sm, "delete-student,100\n"
+                                        "add-student,H,100,70,80\n"
+                                        "add-student,I,200,70,80\n");
+    expect(errorOn(existing, 2).empty(), "a roll number already in the store may be added after its delete");
+    expect(errorOn(existing, 3) == "rollNo", "a roll number already in the store is rejected without a delete");
+
+    std::cout << (failures == 0 ? "Batch delete and re-add: ok" : "Batch delete and re-add: failed") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
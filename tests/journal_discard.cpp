@@ -0,0 +1,57 @@
+#include "../bench/Bench.h"
+#include "../include/Journal.h"
+#include <string>
+
+// A flush drops the journal records it covers and nothing after them: records appended
+// while the data files were on their way must survive the discard, and a discard for an
+// older flush that runs late must not drop anything newer
+static int failures = 0;
+
+static void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cout << "FAILED: " << what << std::endl;
+        failures++;
+    }
+}
+
+static bool append(Journal& journal, const std::string& rollNo) {
+    return journal.append(JournalOp::Enroll, {rollNo, "CS101"});
+}
+
+int main() {
+    Bench::ScratchDirectory scratch("journal-discard");
+    {
+        Journal journal("data/journal.log");
+        expect(append(journal, "1") && append(journal, "2"), "the first records are written");
+        std::uint64_t firstFlush = journal.position();
+        expect(append(journal, "3"), "a record after the first flush is written");
+        std::uint64_t secondFlush = journal.position();
+        expect(append(journal, "4"), "a record after the second flush is written");
+
+        expect(journal.discardBefore(firstFlush), "the first flush discards its records");
+        std::vector<JournalRecord> left = journal.readAll();
+        expect(left.size() == 2 && left[0].fields[0] == "3" && left[1].fields[0] == "4",
+               "the records after the first flush are kept");
+
+        expect(append(journal, "5"), "appending after a discard works");
+        expect(journal.discardBefore(firstFlush), "a stale discard succeeds");
+        expect(journal.readAll().size() == 3, "a stale discard drops nothing");
+
+        expect(journal.discardBefore(secondFlush), "the second flush discards its records");
+        left = journal.readAll();
+        expect(left.size() == 2 && left[0].fields[0] == "4" && left[1].fields[0] == "5",
+               "the records after the second flush are kept");
+
+        expect(journal.discardBefore(journal.position()), "a flush covering everything empties the journal");
+        expect(journal.readAll().empty(), "the journal is empty");
+        expect(append(journal, "6"), "appending to the emptied journal works");
+    }
+
+    // A new Journal on the same file replays what was left
+    Journal reopened("data/journal.log");
+    std::vector<JournalRecord> records = reopened.readAll();
+    expect(records.size() == 1 && records[0].fields[0] == "6", "the last record is all that is replayed");
+
+    std::cout << (failures == 0 ? "Journal discard: ok" : "Journal discard: failed") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,63 @@
+#include "../include/Utils.h"
+#include <fstream>
+#include <iostream>
+#include <regex>
+#include <string>
+
+// Runs every input of the corpus through the std::regex patterns the email and phone
+// validators used to be, and through the hand-written matchers that replaced them
+// Fails on any input where the two disagree or either differs from the expected answer
+static bool regexEmail(const std::string& email) {
+    static const std::regex pattern("(\\w+)(\\.|_)?(\\w*)@(\\w+)(\\.(\\w+))+");
+    return std::regex_match(email, pattern);
+}
+
+static bool regexPhone(const std::string& phone) {
+    static const std::regex pattern("[\\d\\s\\-\\(\\)]+");
+    return std::regex_match(phone, pattern) && phone.length() >= 6;
+}
+
+int main(int argc, char* argv[]) {
+    const char* path = argc >= 2 ? argv[1] : "tests/validators_corpus.txt";
+    std::ifstream corpus(path);
+    if (!corpus) {
+        std::cerr << "Cannot open " << path << std::endl;
+        return 1;
+    }
+
+    std::string line;
+    int lineNumber = 0;
+    int checked = 0;
+    int failures = 0;
+    while (std::getline(corpus, line)) {
+        lineNumber++;
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        // "<kind> <ok|bad> <input>", where the input may be empty or hold spaces of its own
+        std::size_t kindEnd = line.find(' ');
+        std::size_t expectEnd = kindEnd == std::string::npos ? std::string::npos : line.find(' ', kindEnd + 1);
+        std::string kind = line.substr(0, kindEnd);
+        std::string expect = kindEnd == std::string::npos ? "" : line.substr(kindEnd + 1, expectEnd - kindEnd - 1);
+        std::string input = expectEnd == std::string::npos ? "" : line.substr(expectEnd + 1);
+        if ((kind != "email" && kind != "phone") || (expect != "ok" && expect != "bad")) {
+            std::cerr << path << ":" << lineNumber << ": malformed line" << std::endl;
+            return 1;
+        }
+
+        bool expected = expect == "ok";
+        bool old = kind == "email" ? regexEmail(input) : regexPhone(input);
+        bool now = kind == "email" ? Validation::isValidEmail(input) : Validation::isValidPhone(input);
+        checked++;
+        if (old != expected || now != expected) {
+            failures++;
+            std::cout << path << ":" << lineNumber << ": " << kind << " \"" << input << "\" expected " << expect
+                      << ", regex says " << (old ? "ok" : "bad") << ", matcher says " << (now ? "ok" : "bad")
+                      << std::endl;
+        }
+    }
+
+    std::cout << checked << " validator inputs, " << failures << " failed" << std::endl;
+    return failures == 0 ? 0 : 1;
+}